@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "graphics.h"
+
+namespace graphics {
+
+// A proportional anti-aliased font as emitted by tools/font_convert.py:
+// glyphs are 4-bpp coverage (0 none, 15 full), trimmed to their ink, two
+// pixels per byte with the first in the low nibble.
+struct AaGlyph {
+  uint16_t offset;  // first byte in the font's bitmaps
+  uint8_t width;
+  uint8_t height;
+  int8_t left;      // from the pen to the first column
+  uint8_t top;      // from the top of the line to the first row
+  uint8_t advance;
+};
+
+struct AaFont {
+  // Glyph per ASCII code 0x20..0x7E, kNoGlyph for characters left out.
+  const uint8_t *index;
+  const AaGlyph *glyphs;
+  const uint8_t *bitmaps;
+  uint8_t height;    // rows from the highest glyph top to the lowest bottom
+  uint8_t baseline;  // rows from the top of the line
+};
+
+inline constexpr uint8_t kNoGlyph = 0xFF;
+
+// The first line of `text` in `font` with its line box's top-left at
+// (x, y). Glyph edges are blended toward a known background while the
+// rows are built, so nothing is read back from the screen.
+struct AaTextRun {
+  const AaFont *font = nullptr;
+  const char *text = nullptr;
+  int16_t x = 0;
+  int16_t y = 0;
+  // Color for each coverage level, 0 being the background.
+  uint16_t ramp[16] = {};
+
+  // Builds the ramp from `color` over `background`. With fewer `shades`
+  // coverage is rounded to that many levels, e.g. to keep a palette from
+  // filling up with edge colors.
+  void setColors(uint16_t color, uint16_t background, uint8_t shades = 16);
+};
+
+// Width of the first line of `text`: the sum of its advances.
+int16_t aaTextWidth(const AaFont &font, const char *text);
+
+// A RowSource over an AaTextRun (passed as `context`).
+void readAaTextRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest);
+
+// Paints the box in the run's background with the run's text clipped to
+// it, every pixel once, through Graphics::drawRows: the whole box leaves in
+// one window and costs what a drawTextBox of the same size does. The run is
+// read when the rows are, so it must stay valid until the frame is flushed.
+template <typename Display>
+void drawAaTextBox(Display &display, int16_t x, int16_t y, int16_t w, int16_t h, const AaTextRun &run) {
+  if (!run.font || !run.text) return;
+  display.drawRows(x, y, w, h, readAaTextRow, const_cast<AaTextRun *>(&run));
+}
+
+}  // namespace graphics
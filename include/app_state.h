@@ -8,14 +8,6 @@ namespace app_state {
 
 struct DisplayState {
   tm currentTime{};
-  int prevHourX = 0;
-  int prevHourY = 0;
-  int prevMinuteX = 0;
-  int prevMinuteY = 0;
-  int prevSecondX = 0;
-  int prevSecondY = 0;
-  int prevSecondTailX = 0;
-  int prevSecondTailY = 0;
   unsigned long lastTickMs = 0;
   unsigned long rtcBaseMs = 0;
   enum class Screen : uint8_t { Watchface = 0, Info = 1 };
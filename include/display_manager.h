@@ -1,13 +1,56 @@
 #pragma once
 
+#include <type_traits>
+
 #include "graphics.h"
 
+namespace graphics {
+class Gc9a01Graphics;
+class IndexedCanvas;
+class RecordingGraphics;
+}
+
 namespace display_manager {
 
 void init();
 graphics::Graphics &get();
+graphics::Gc9a01Graphics &panel();
 void begin(uint32_t freq_hz = 40000000ul);
 void reinitializeAfterWake();
+graphics::TransferStats transferStats();
+void resetTransferStats();
+// True when renderFrame() replays its scene once per strip of rows.
+bool bandedRendering();
+
+// Replays `scene` once per strip of rows into the panel and returns true
+// in the banded render mode; otherwise returns false without calling it.
+bool renderBanded(void (*scene)(graphics::Gc9a01Graphics &display, void *context), void *context);
+
+namespace detail {
+graphics::RecordingGraphics *recorder();
+graphics::IndexedCanvas *canvas();
+}  // namespace detail
+
+// Calls `draw` with whichever backend get() returns, as its own type, so
+// templated drawing code binds its calls at compile time.
+template <typename Draw>
+auto withDisplay(Draw &&draw) {
+  if (graphics::RecordingGraphics *recorder = detail::recorder()) return draw(*recorder);
+  if (graphics::IndexedCanvas *canvas = detail::canvas()) return draw(*canvas);
+  return draw(panel());
+}
+
+// Draws a complete frame. `scene` is called with the backend as its own
+// type; in the banded render mode it runs once per strip of rows, so it
+// must paint every pixel and be safe to repeat.
+template <typename Scene>
+void renderFrame(Scene &&scene) {
+  using Fn = std::remove_reference_t<Scene>;
+  const bool banded = renderBanded(
+    [](graphics::Gc9a01Graphics &display, void *context) { (*static_cast<Fn *>(context))(display); },
+    const_cast<void *>(static_cast<const void *>(&scene)));
+  if (!banded) withDisplay(scene);
+}
 
 }  // namespace display_manager
 
@@ -0,0 +1,213 @@
+#pragma once
+
+// Generated by tools/font_convert.py from Lato-Regular.ttf at --height 14; do not edit.
+
+#include "aa_text.h"
+
+namespace graphics {
+namespace fonts {
+
+inline constexpr uint8_t kLato14Index[95] = {
+  0x00,0xff,0xff,0xff,0xff,0x01,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+  0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0xff,0xff,0xff,0xff,0xff,0xff,
+  0xff,0x0c,0x0d,0x0e,0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,
+  0x1b,0x1c,0x1d,0x1e,0x1f,0x20,0x21,0x22,0x23,0x24,0x25,0xff,0xff,0xff,0xff,0xff,
+  0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+  0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+};
+
+inline constexpr AaGlyph kLato14Glyphs[38] = {
+  {0, 0, 0, 0, 0, 3},  // ' '
+  {0, 12, 13, 0, 0, 13},  // '%'
+  {78, 9, 13, 0, 0, 9},  // '0'
+  {143, 8, 12, 1, 0, 9},  // '1'
+  {191, 9, 12, 0, 0, 9},  // '2'
+  {251, 8, 13, 1, 0, 9},  // '3'
+  {303, 9, 12, 0, 0, 9},  // '4'
+  {363, 8, 13, 1, 0, 9},  // '5'
+  {415, 9, 13, 0, 0, 9},  // '6'
+  {480, 9, 12, 0, 0, 9},  // '7'
+  {540, 9, 13, 0, 0, 9},  // '8'
+  {605, 8, 12, 1, 0, 9},  // '9'
+  {653, 11, 12, 0, 0, 11},  // 'A'
+  {725, 9, 12, 1, 0, 10},  // 'B'
+  {785, 11, 13, 0, 0, 11},  // 'C'
+  {863, 11, 12, 1, 0, 12},  // 'D'
+  {935, 8, 12, 1, 0, 9},  // 'E'
+  {983, 8, 12, 1, 0, 9},  // 'F'
+  {1031, 11, 13, 0, 0, 12},  // 'G'
+  {1109, 10, 12, 1, 0, 12},  // 'H'
+  {1169, 3, 12, 1, 0, 5},  // 'I'
+  {1193, 6, 13, 0, 0, 7},  // 'J'
+  {1232, 10, 12, 1, 0, 11},  // 'K'
+  {1292, 7, 12, 1, 0, 8},  // 'L'
+  {1340, 13, 12, 1, 0, 15},  // 'M'
+  {1424, 10, 12, 1, 0, 12},  // 'N'
+  {1484, 13, 13, 0, 0, 13},  // 'O'
+  {1575, 9, 12, 1, 0, 10},  // 'P'
+  {1635, 13, 15, 0, 0, 13},  // 'Q'
+  {1740, 9, 12, 1, 0, 10},  // 'R'
+  {1800, 8, 13, 0, 0, 9},  // 'S'
+  {1852, 10, 12, 0, 0, 9},  // 'T'
+  {1912, 10, 13, 1, 0, 12},  // 'U'
+  {1977, 11, 12, 0, 0, 11},  // 'V'
+  {2049, 17, 12, 0, 0, 16},  // 'W'
+  {2157, 10, 12, 0, 0, 10},  // 'X'
+  {2217, 10, 12, 0, 0, 10},  // 'Y'
+  {2277, 10, 12, 0, 0, 10},  // 'Z'
+};
+
+inline constexpr uint8_t kLato14Bitmaps[2337] = {
+  0x20,0x98,0x03,0x00,0x20,0x17,0xd1,0x68,0x3e,0x00,0xc0,0x08,0xc5,0x00,0x98,0x00,
+  0xb9,0x00,0xb6,0x00,0xa7,0x50,0x1e,0x00,0xe3,0x01,0x6b,0xe2,0x04,0x00,0x80,0xee,
+  0x1a,0x8c,0x00,0x00,0x00,0x11,0x80,0x0b,0x96,0x06,0x00,0x00,0xe5,0x82,0x6b,0x8c,
+  0x00,0x20,0x4e,0xe0,0x02,0xe3,0x00,0xc0,0x08,0xf1,0x01,0xf2,0x00,0xc8,0x00,0xd0,
+  0x05,0xc6,0x40,0x2e,0x00,0x30,0xdd,0x3d,0x00,0x00,0x00,0x00,0x20,0x00,0x00,0x71,
+  0x89,0x02,0x00,0x20,0xdd,0xc9,0x5f,0x00,0xb0,0x1c,0x00,0xe9,0x01,0xf2,0x05,0x00,
+  0xf1,0x07,0xf6,0x01,0x00,0xc0,0x0a,0xf7,0x00,0x00,0xa0,0x0c,0xe8,0x00,0x00,0xa0,
+  0x0c,0xf7,0x00,0x00,0xb0,0x0b,0xf4,0x03,0x00,0xd0,0x09,0xe1,0x08,0x00,0xf4,0x04,
+  0x60,0x7f,0x42,0xbd,0x00,0x00,0xe7,0xff,0x1a,0x00,0x00,0x00,0x12,0x00,0x00,0x00,
+  0x20,0x28,0x00,0x00,0xe3,0x3f,0x00,0x50,0xce,0x3f,0x00,0xf2,0x37,0x3f,0x00,0x20,
+  0x30,0x3f,0x00,0x00,0x30,0x3f,0x00,0x00,0x30,0x3f,0x00,0x00,0x30,0x3f,0x00,0x00,
+  0x30,0x3f,0x00,0x00,0x30,0x3f,0x00,0x10,0x52,0x5f,0x12,0xa0,0xff,0xff,0x7f,0x00,
+  0x61,0x99,0x04,0x00,0x10,0xed,0xba,0x8f,0x00,0x90,0x1d,0x00,0xf8,0x01,0x90,0x05,
+  0x00,0xf3,0x04,0x00,0x00,0x00,0xf5,0x02,0x00,0x00,0x00,0xbc,0x00,0x00,0x00,0x90,
+  0x2e,0x00,0x00,0x00,0xe8,0x03,0x00,0x00,0x80,0x3e,0x00,0x00,0x00,0xe8,0x03,0x00,
+  0x00,0x80,0x8f,0x66,0x66,0x02,0xf2,0xff,0xff,0xff,0x08,0x00,0x95,0x59,0x00,0xb0,
+  0xae,0xfa,0x0a,0xe7,0x02,0x50,0x3f,0x77,0x00,0x10,0x5f,0x00,0x00,0x50,0x2f,0x00,
+  0x50,0xd9,0x05,0x00,0x70,0xeb,0x07,0x00,0x00,0x40,0x5f,0x02,0x00,0x00,0x8d,0x7e,
+  0x00,0x10,0x7e,0xf8,0x26,0xb3,0x2e,0x80,0xfe,0xcf,0x03,0x00,0x20,0x01,0x00,0x00,
+  0x00,0x20,0x28,0x00,0x00,0x00,0xc0,0x4f,0x00,0x00,0x00,0xc9,0x4f,0x00,0x00,0x50,
+  0x2e,0x4f,0x00,0x00,0xe2,0x05,0x4f,0x00,0x10,0x9c,0x00,0x4f,0x00,0x90,0x1c,0x00,
+  0x4f,0x00,0xf5,0x24,0x22,0x5f,0x02,0xf8,0xff,0xff,0xff,0x0e,0x00,0x00,0x00,0x4f,
+  0x00,0x00,0x00,0x00,0x4f,0x00,0x00,0x00,0x00,0x4f,0x00,0x50,0x88,0x88,0x06,0xc0,
+  0xde,0xdd,0x09,0xe0,0x04,0x00,0x00,0xf2,0x02,0x00,0x00,0xe4,0x64,0x04,0x00,0xf7,
+  0xdd,0xdf,0x03,0x10,0x00,0xc2,0x0c,0x00,0x00,0x50,0x2f,0x00,0x00,0x40,0x3f,0x00,
+  0x00,0x80,0x0e,0x8b,0x23,0xf7,0x07,0xd6,0xff,0x6d,0x00,0x00,0x21,0x00,0x00,0x00,
+  0x00,0x50,0x07,0x00,0x00,0x00,0xf5,0x06,0x00,0x00,0x20,0xae,0x00,0x00,0x00,0xc0,
+  0x1c,0x00,0x00,0x00,0xe8,0x02,0x00,0x00,0x30,0xdf,0xfe,0x4c,0x00,0xb0,0x6e,0x31,
+  0xeb,0x02,0xf1,0x07,0x00,0xe1,0x08,0xf2,0x04,0x00,0xd0,0x09,0xe0,0x07,0x00,0xf1,
+  0x07,0x80,0x5e,0x32,0xdb,0x01,0x00,0xe8,0xff,0x2b,0x00,0x00,0x00,0x12,0x00,0x00,
+  0x81,0x88,0x88,0x88,0x05,0xd1,0xdd,0xdd,0xfd,0x09,0x00,0x00,0x00,0xf3,0x03,0x00,
+  0x00,0x00,0xbb,0x00,0x00,0x00,0x30,0x3f,0x00,0x00,0x00,0xb0,0x0b,0x00,0x00,0x00,
+  0xf4,0x03,0x00,0x00,0x00,0xbb,0x00,0x00,0x00,0x40,0x4f,0x00,0x00,0x00,0xc0,0x0b,
+  0x00,0x00,0x00,0xf4,0x04,0x00,0x00,0x00,0xbc,0x00,0x00,0x00,0x00,0x71,0x89,0x03,
+  0x00,0x20,0xce,0xa8,0x6f,0x00,0xa0,0x0c,0x00,0xe8,0x00,0xc0,0x09,0x00,0xf4,0x01,
+  0x90,0x0c,0x00,0xd8,0x00,0x10,0xcb,0xb8,0x3d,0x00,0x30,0xdc,0xb9,0x6e,0x00,0xd0,
+  0x0a,0x00,0xf6,0x03,0xf3,0x04,0x00,0xf0,0x07,0xf2,0x06,0x00,0xf1,0x07,0xb0,0x4d,
+  0x20,0xeb,0x02,0x10,0xfa,0xff,0x3c,0x00,0x00,0x00,0x12,0x00,0x00,0x00,0x95,0x59,
+  0x00,0xb0,0xae,0xea,0x0a,0xe7,0x02,0x30,0x5f,0xab,0x00,0x00,0x9c,0xab,0x00,0x00,
+  0x9c,0xf7,0x04,0x60,0x6f,0xa0,0xdf,0xee,0x1e,0x00,0x42,0xe4,0x06,0x00,0x10,0xac,
+  0x00,0x00,0xa0,0x1e,0x00,0x00,0xf6,0x05,0x00,0x30,0x9f,0x00,0x00,0x00,0x00,0x83,
+  0x03,0x00,0x00,0x00,0x00,0xfb,0x0a,0x00,0x00,0x00,0x20,0xaf,0x1f,0x00,0x00,0x00,
+  0x80,0x1e,0x7e,0x00,0x00,0x00,0xe0,0x09,0xda,0x00,0x00,0x00,0xf5,0x03,0xf4,0x04,
+  0x00,0x00,0xcb,0x00,0xd0,0x0a,0x00,0x20,0x9f,0x44,0xa4,0x1f,0x00,0x80,0xdf,0xdd,
+  0xdd,0x7f,0x00,0xe0,0x0a,0x00,0x00,0xdb,0x00,0xf5,0x04,0x00,0x00,0xf5,0x04,0xcb,
+  0x00,0x00,0x00,0xd0,0x0a,0x85,0x88,0x58,0x01,0x00,0xf9,0xbb,0xeb,0x5e,0x00,0xe9,
+  0x00,0x10,0xec,0x00,0xe9,0x00,0x00,0xf7,0x01,0xe9,0x00,0x00,0xda,0x00,0xf9,0x66,
+  0xa6,0x3d,0x00,0xf9,0xbb,0xdb,0x4b,0x00,0xe9,0x00,0x00,0xf8,0x03,0xe9,0x00,0x00,
+  0xf1,0x07,0xe9,0x00,0x00,0xf3,0x06,0xe9,0x44,0x64,0xdd,0x01,0xf9,0xff,0xef,0x29,
+  0x00,0x00,0x00,0x85,0x89,0x04,0x00,0x00,0xd3,0xdf,0xcb,0xcf,0x01,0x20,0xde,0x03,
+  0x00,0x93,0x00,0xa0,0x2e,0x00,0x00,0x00,0x00,0xf1,0x09,0x00,0x00,0x00,0x00,0xf3,
+  0x06,0x00,0x00,0x00,0x00,0xf4,0x05,0x00,0x00,0x00,0x00,0xf3,0x07,0x00,0x00,0x00,
+  0x00,0xe0,0x0c,0x00,0x00,0x00,0x00,0x70,0x6f,0x00,0x00,0x40,0x00,0x00,0xfb,0x5a,
+  0x54,0xeb,0x02,0x00,0x70,0xfd,0xff,0x3b,0x00,0x00,0x00,0x10,0x02,0x00,0x00,0x85,
+  0x88,0x78,0x04,0x00,0x00,0xf9,0xbb,0xcb,0xdf,0x03,0x00,0xe9,0x00,0x00,0xc2,0x3e,
+  0x00,0xe9,0x00,0x00,0x10,0xbd,0x00,0xe9,0x00,0x00,0x00,0xf7,0x02,0xe9,0x00,0x00,
+  0x00,0xf4,0x05,0xe9,0x00,0x00,0x00,0xf4,0x05,0xe9,0x00,0x00,0x00,0xf5,0x04,0xe9,
+  0x00,0x00,0x00,0xea,0x01,0xe9,0x00,0x00,0x50,0x7f,0x00,0xf9,0x44,0x54,0xfa,0x0a,
+  0x00,0xf9,0xff,0xef,0x5b,0x00,0x00,0x85,0x88,0x88,0x48,0xf9,0xbb,0xbb,0x5b,0xe9,
+  0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xf9,0x66,0x66,0x02,0xf9,
+  0xbb,0xbb,0x05,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xf9,
+  0x44,0x44,0x24,0xf9,0xff,0xff,0x7f,0x85,0x88,0x88,0x48,0xf9,0xbb,0xbb,0x5b,0xe9,
+  0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xf9,0x44,0x44,0x03,0xf9,
+  0xff,0xff,0x0a,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,
+  0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0x00,0x00,0x85,0x99,0x16,0x00,0x00,0xd3,0xdf,
+  0xcb,0xef,0x04,0x20,0xde,0x03,0x00,0x91,0x04,0xb0,0x2e,0x00,0x00,0x00,0x00,0xf1,
+  0x09,0x00,0x00,0x00,0x00,0xf3,0x05,0x00,0x00,0x00,0x00,0xf4,0x05,0x00,0x60,0x88,
+  0x06,0xf2,0x07,0x00,0x70,0xd9,0x0c,0xd0,0x0b,0x00,0x00,0x90,0x0c,0x60,0x6f,0x00,
+  0x00,0x90,0x0c,0x00,0xfa,0x49,0x32,0xd7,0x0c,0x00,0x60,0xfc,0xff,0x9e,0x02,0x00,
+  0x00,0x10,0x12,0x00,0x00,0x75,0x00,0x00,0x00,0x56,0xe9,0x00,0x00,0x00,0xbd,0xe9,
+  0x00,0x00,0x00,0xbd,0xe9,0x00,0x00,0x00,0xbd,0xe9,0x00,0x00,0x00,0xbd,0xf9,0x66,
+  0x66,0x66,0xbe,0xf9,0xbb,0xbb,0xbb,0xbe,0xe9,0x00,0x00,0x00,0xbd,0xe9,0x00,0x00,
+  0x00,0xbd,0xe9,0x00,0x00,0x00,0xbd,0xe9,0x00,0x00,0x00,0xbd,0xe9,0x00,0x00,0x00,
+  0xbd,0x82,0x02,0xf5,0x04,0xf5,0x04,0xf5,0x04,0xf5,0x04,0xf5,0x04,0xf5,0x04,0xf5,
+  0x04,0xf5,0x04,0xf5,0x04,0xf5,0x04,0xf5,0x04,0x00,0x00,0x56,0x00,0x00,0xbc,0x00,
+  0x00,0xbc,0x00,0x00,0xbc,0x00,0x00,0xbc,0x00,0x00,0xbc,0x00,0x00,0xbc,0x00,0x00,
+  0xbc,0x00,0x00,0xad,0x00,0x10,0x8f,0x32,0xb4,0x2f,0xf7,0xdf,0x04,0x10,0x02,0x00,
+  0x83,0x01,0x00,0x40,0x28,0xf7,0x02,0x00,0xf4,0x08,0xf7,0x02,0x20,0xae,0x00,0xf7,
+  0x02,0xd1,0x0b,0x00,0xf7,0x12,0xcc,0x01,0x00,0xf7,0xc8,0x2d,0x00,0x00,0xf7,0xdc,
+  0x3e,0x00,0x00,0xf7,0x12,0xdd,0x01,0x00,0xf7,0x02,0xe2,0x0c,0x00,0xf7,0x02,0x40,
+  0xaf,0x00,0xf7,0x02,0x00,0xf5,0x07,0xf7,0x02,0x00,0x70,0x5f,0x75,0x00,0x00,0x00,
+  0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,
+  0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,
+  0xe9,0x00,0x00,0x00,0xe9,0x44,0x44,0x03,0xf9,0xff,0xff,0x0e,0x75,0x01,0x00,0x00,
+  0x00,0x82,0x03,0xf9,0x07,0x00,0x00,0x00,0xfb,0x05,0xf9,0x1e,0x00,0x00,0x40,0xff,
+  0x05,0xc9,0x9d,0x00,0x00,0xc0,0xfa,0x05,0xb9,0xf5,0x03,0x00,0xf6,0xf2,0x05,0xb9,
+  0xb0,0x0b,0x10,0x8d,0xf0,0x05,0xb9,0x30,0x4f,0x70,0x1e,0xf0,0x05,0xb9,0x00,0xda,
+  0xe2,0x07,0xf0,0x05,0xb9,0x00,0xf2,0xdc,0x00,0xf0,0x05,0xb9,0x00,0x80,0x5f,0x00,
+  0xf0,0x05,0xb9,0x00,0x10,0x04,0x00,0xf0,0x05,0xb9,0x00,0x00,0x00,0x00,0xf0,0x05,
+  0x55,0x00,0x00,0x00,0x55,0xf9,0x05,0x00,0x00,0xba,0xf9,0x2e,0x00,0x00,0xba,0xc9,
+  0xcd,0x00,0x00,0xba,0xb9,0xf3,0x09,0x00,0xba,0xb9,0x60,0x6f,0x00,0xba,0xb9,0x00,
+  0xe9,0x03,0xba,0xb9,0x00,0xc1,0x1d,0xba,0xb9,0x00,0x20,0xae,0xba,0xb9,0x00,0x00,
+  0xf5,0xbe,0xb9,0x00,0x00,0x80,0xbf,0xb9,0x00,0x00,0x00,0xbb,0x00,0x00,0x85,0x89,
+  0x04,0x00,0x00,0x00,0xd3,0xcf,0xdb,0xcf,0x02,0x00,0x20,0xce,0x02,0x00,0xe4,0x1d,
+  0x00,0xa0,0x1e,0x00,0x00,0x30,0x7f,0x00,0xf1,0x09,0x00,0x00,0x00,0xdc,0x00,0xf3,
+  0x06,0x00,0x00,0x00,0xf9,0x00,0xf4,0x05,0x00,0x00,0x00,0xf8,0x01,0xf2,0x07,0x00,
+  0x00,0x00,0xea,0x00,0xd0,0x0c,0x00,0x00,0x10,0xae,0x00,0x60,0x6f,0x00,0x00,0x90,
+  0x4f,0x00,0x00,0xfa,0x5a,0x64,0xfb,0x07,0x00,0x00,0x60,0xfc,0xff,0x4b,0x00,0x00,
+  0x00,0x00,0x10,0x02,0x00,0x00,0x00,0x83,0x88,0x57,0x01,0x00,0xf7,0xbc,0xec,0x3e,
+  0x00,0xf7,0x02,0x10,0xdc,0x00,0xf7,0x02,0x00,0xf6,0x03,0xf7,0x02,0x00,0xf6,0x03,
+  0xf7,0x02,0x00,0xec,0x00,0xf7,0x88,0xd9,0x5f,0x00,0xf7,0xbc,0x8a,0x02,0x00,0xf7,
+  0x02,0x00,0x00,0x00,0xf7,0x02,0x00,0x00,0x00,0xf7,0x02,0x00,0x00,0x00,0xf7,0x02,
+  0x00,0x00,0x00,0x00,0x00,0x85,0x89,0x04,0x00,0x00,0x00,0xd3,0xcf,0xdb,0xcf,0x02,
+  0x00,0x20,0xce,0x02,0x00,0xe4,0x1d,0x00,0xa0,0x1e,0x00,0x00,0x30,0x7f,0x00,0xf1,
+  0x09,0x00,0x00,0x00,0xdc,0x00,0xf3,0x06,0x00,0x00,0x00,0xf9,0x00,0xf4,0x05,0x00,
+  0x00,0x00,0xf8,0x01,0xf2,0x07,0x00,0x00,0x00,0xea,0x00,0xd0,0x0c,0x00,0x00,0x10,
+  0xae,0x00,0x60,0x6f,0x00,0x00,0x90,0x3f,0x00,0x00,0xfa,0x5a,0x64,0xfb,0x07,0x00,
+  0x00,0x60,0xfc,0xff,0xde,0x01,0x00,0x00,0x00,0x10,0x02,0xd2,0x1c,0x00,0x00,0x00,
+  0x00,0x00,0x20,0xbe,0x01,0x00,0x00,0x00,0x00,0x00,0x62,0x02,0x83,0x88,0x57,0x00,
+  0x00,0xf7,0xbc,0xfc,0x3d,0x00,0xf7,0x02,0x20,0xcd,0x00,0xf7,0x02,0x00,0xf8,0x00,
+  0xf7,0x02,0x00,0xe9,0x00,0xf7,0x02,0x60,0x7f,0x00,0xf7,0xdd,0xdf,0x06,0x00,0xf7,
+  0x45,0xbe,0x00,0x00,0xf7,0x02,0xf4,0x07,0x00,0xf7,0x02,0x80,0x3f,0x00,0xf7,0x02,
+  0x00,0xdc,0x01,0xf7,0x02,0x00,0xe2,0x0a,0x00,0x72,0x89,0x03,0x40,0xde,0xda,0x6f,
+  0xc0,0x0b,0x00,0x25,0xf0,0x07,0x00,0x00,0xd0,0x2c,0x00,0x00,0x50,0xff,0x5a,0x00,
+  0x00,0x82,0xfd,0x2d,0x00,0x00,0x40,0xbe,0x00,0x00,0x00,0xd9,0x30,0x00,0x00,0xca,
+  0xf5,0x49,0x83,0x5f,0x60,0xfd,0xdf,0x06,0x00,0x10,0x02,0x00,0x86,0x88,0x88,0x88,
+  0x28,0xb9,0xbb,0xdf,0xbb,0x3b,0x00,0x10,0x8f,0x00,0x00,0x00,0x10,0x8f,0x00,0x00,
+  0x00,0x10,0x8f,0x00,0x00,0x00,0x10,0x8f,0x00,0x00,0x00,0x10,0x8f,0x00,0x00,0x00,
+  0x10,0x8f,0x00,0x00,0x00,0x10,0x8f,0x00,0x00,0x00,0x10,0x8f,0x00,0x00,0x00,0x10,
+  0x8f,0x00,0x00,0x00,0x10,0x8f,0x00,0x00,0x65,0x00,0x00,0x10,0x38,0xcb,0x00,0x00,
+  0x20,0x7f,0xcb,0x00,0x00,0x20,0x7f,0xcb,0x00,0x00,0x20,0x7f,0xcb,0x00,0x00,0x20,
+  0x7f,0xcb,0x00,0x00,0x20,0x7f,0xcb,0x00,0x00,0x20,0x7f,0xdb,0x00,0x00,0x20,0x6f,
+  0xe9,0x00,0x00,0x40,0x5f,0xf5,0x06,0x00,0xa0,0x1e,0xb0,0x8f,0x54,0xfb,0x07,0x10,
+  0xe8,0xff,0x6d,0x00,0x00,0x00,0x12,0x00,0x00,0x66,0x00,0x00,0x00,0x60,0x06,0xf8,
+  0x02,0x00,0x00,0xf3,0x06,0xf2,0x07,0x00,0x00,0xe9,0x01,0xb0,0x0d,0x00,0x10,0x9e,
+  0x00,0x50,0x4f,0x00,0x60,0x3f,0x00,0x00,0xad,0x00,0xc0,0x0c,0x00,0x00,0xf7,0x02,
+  0xf3,0x06,0x00,0x00,0xf2,0x07,0xe9,0x01,0x00,0x00,0xa0,0x1d,0x9e,0x00,0x00,0x00,
+  0x40,0x9f,0x3f,0x00,0x00,0x00,0x00,0xfd,0x0b,0x00,0x00,0x00,0x00,0xf7,0x05,0x00,
+  0x00,0x66,0x00,0x00,0x30,0x07,0x00,0x00,0x83,0x01,0xf9,0x02,0x00,0xb0,0x3f,0x00,
+  0x00,0xea,0x00,0xf4,0x06,0x00,0xf1,0x8f,0x00,0x00,0x9e,0x00,0xe0,0x0b,0x00,0xe6,
+  0xd9,0x00,0x40,0x4f,0x00,0xa0,0x1f,0x00,0x9b,0xf4,0x03,0x90,0x0e,0x00,0x50,0x5f,
+  0x20,0x4f,0xe0,0x08,0xd0,0x0a,0x00,0x10,0x9f,0x70,0x0e,0x90,0x0d,0xf3,0x05,0x00,
+  0x00,0xdb,0xc0,0x09,0x40,0x3f,0xf7,0x01,0x00,0x00,0xf6,0xf5,0x04,0x00,0x8e,0xbc,
+  0x00,0x00,0x00,0xf1,0xed,0x00,0x00,0xd9,0x6f,0x00,0x00,0x00,0xc0,0x9f,0x00,0x00,
+  0xf4,0x2f,0x00,0x00,0x00,0x70,0x4f,0x00,0x00,0xe0,0x0c,0x00,0x00,0x84,0x02,0x00,
+  0x00,0x76,0xe2,0x0b,0x00,0x40,0x6f,0x60,0x6f,0x00,0xd1,0x0a,0x00,0xea,0x01,0xea,
+  0x01,0x00,0xe1,0x5a,0x5f,0x00,0x00,0x50,0xef,0x09,0x00,0x00,0x30,0xff,0x08,0x00,
+  0x00,0xd0,0x7c,0x3f,0x00,0x00,0xe8,0x02,0xdc,0x00,0x30,0x7f,0x00,0xf3,0x08,0xd1,
+  0x0c,0x00,0x80,0x3f,0xe8,0x02,0x00,0x10,0xcd,0x66,0x00,0x00,0x00,0x76,0xf5,0x05,
+  0x00,0x40,0x7f,0xb0,0x1d,0x00,0xc0,0x0c,0x20,0x8f,0x00,0xf6,0x03,0x00,0xf8,0x12,
+  0x9e,0x00,0x00,0xd0,0x8a,0x1e,0x00,0x00,0x40,0xef,0x06,0x00,0x00,0x00,0xdc,0x00,
+  0x00,0x00,0x00,0xcb,0x00,0x00,0x00,0x00,0xcb,0x00,0x00,0x00,0x00,0xcb,0x00,0x00,
+  0x00,0x00,0xcb,0x00,0x00,0x80,0x88,0x88,0x88,0x38,0xb0,0xbb,0xbb,0xeb,0x4f,0x00,
+  0x00,0x00,0xf3,0x09,0x00,0x00,0x10,0xdd,0x01,0x00,0x00,0x90,0x3f,0x00,0x00,0x00,
+  0xf4,0x07,0x00,0x00,0x10,0xbe,0x00,0x00,0x00,0xb0,0x2e,0x00,0x00,0x00,0xf6,0x05,
+  0x00,0x00,0x30,0x9f,0x00,0x00,0x00,0xc0,0x4e,0x44,0x44,0x14,0xf4,0xff,0xff,0xff,
+  0x4f,
+};
+
+inline constexpr AaFont kLato14 = {kLato14Index, kLato14Glyphs, kLato14Bitmaps, 15, 12};
+
+}  // namespace fonts
+}  // namespace graphics
@@ -0,0 +1,179 @@
+#pragma once
+
+// Generated by tools/font_convert.py from Lato-Regular.ttf at --height 24; do not edit.
+
+#include "aa_text.h"
+
+namespace graphics {
+namespace fonts {
+
+inline constexpr uint8_t kLato24Index[95] = {
+  0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+  0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0xff,0xff,0xff,0xff,0xff,
+  0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+  0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+  0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+  0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+};
+
+inline constexpr AaGlyph kLato24Glyphs[12] = {
+  {0, 0, 0, 0, 0, 6},  // ' '
+  {0, 17, 25, 1, 0, 19},  // '0'
+  {225, 15, 24, 3, 0, 19},  // '1'
+  {417, 17, 24, 1, 0, 19},  // '2'
+  {633, 17, 25, 1, 0, 19},  // '3'
+  {858, 19, 24, 0, 0, 19},  // '4'
+  {1098, 16, 25, 1, 0, 19},  // '5'
+  {1298, 17, 25, 1, 0, 19},  // '6'
+  {1523, 17, 24, 1, 0, 19},  // '7'
+  {1739, 17, 25, 1, 0, 19},  // '8'
+  {1964, 16, 24, 2, 0, 19},  // '9'
+  {2156, 5, 18, 2, 7, 8},  // ':'
+};
+
+inline constexpr uint8_t kLato24Bitmaps[2210] = {
+  0x00,0x00,0x30,0xa7,0xab,0x27,0x00,0x00,0x00,0x00,0x10,0xfa,0xff,0xff,0xff,0x1a,
+  0x00,0x00,0x00,0xd1,0xff,0xdf,0xdb,0xff,0xdf,0x01,0x00,0x00,0xfc,0xcf,0x03,0x00,
+  0xc3,0xff,0x0b,0x00,0x60,0xff,0x1d,0x00,0x00,0x10,0xfd,0x6f,0x00,0xd0,0xff,0x04,
+  0x00,0x00,0x00,0xf4,0xdf,0x00,0xf3,0xcf,0x00,0x00,0x00,0x00,0xd0,0xff,0x03,0xf8,
+  0x8f,0x00,0x00,0x00,0x00,0x80,0xff,0x08,0xfb,0x4f,0x00,0x00,0x00,0x00,0x50,0xff,
+  0x0b,0xfd,0x2f,0x00,0x00,0x00,0x00,0x20,0xff,0x0d,0xfe,0x1f,0x00,0x00,0x00,0x00,
+  0x10,0xff,0x0e,0xff,0x0f,0x00,0x00,0x00,0x00,0x00,0xff,0x0f,0xff,0x0f,0x00,0x00,
+  0x00,0x00,0x00,0xff,0x0f,0xff,0x0f,0x00,0x00,0x00,0x00,0x10,0xff,0x0f,0xfe,0x1f,
+  0x00,0x00,0x00,0x00,0x20,0xff,0x0e,0xfc,0x3f,0x00,0x00,0x00,0x00,0x30,0xff,0x0c,
+  0xf9,0x6f,0x00,0x00,0x00,0x00,0x60,0xff,0x09,0xf6,0xaf,0x00,0x00,0x00,0x00,0xa0,
+  0xff,0x06,0xf1,0xef,0x01,0x00,0x00,0x00,0xe1,0xff,0x01,0xa0,0xff,0x08,0x00,0x00,
+  0x00,0xf8,0xaf,0x00,0x20,0xff,0x5f,0x00,0x00,0x50,0xff,0x2f,0x00,0x00,0xf6,0xff,
+  0x5a,0x54,0xfa,0xff,0x06,0x00,0x00,0x70,0xff,0xff,0xff,0xff,0x6f,0x00,0x00,0x00,
+  0x00,0xa3,0xff,0xff,0xae,0x03,0x00,0x00,0x00,0x00,0x00,0x30,0x34,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x71,0x58,0x00,0x00,0x00,0x00,0x00,0x10,0xfc,0xaf,0x00,0x00,
+  0x00,0x00,0x00,0xd3,0xff,0xaf,0x00,0x00,0x00,0x00,0x40,0xfe,0xff,0xaf,0x00,0x00,
+  0x00,0x00,0xf6,0xff,0xfb,0xaf,0x00,0x00,0x00,0x80,0xff,0x6f,0xf4,0xaf,0x00,0x00,
+  0x00,0xf7,0xef,0x04,0xf4,0xaf,0x00,0x00,0x00,0xd1,0x3d,0x00,0xf4,0xaf,0x00,0x00,
+  0x00,0x10,0x01,0x00,0xf4,0xaf,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xf4,0xaf,0x00,0x00,0x00,0x10,0x44,0x44,0xf7,0xbf,0x44,0x44,
+  0x01,0x40,0xff,0xff,0xff,0xff,0xff,0xff,0x04,0x40,0xff,0xff,0xff,0xff,0xff,0xff,
+  0x04,0x00,0x00,0x20,0xa6,0xbb,0x59,0x00,0x00,0x00,0x00,0x10,0xf9,0xff,0xff,0xff,
+  0x5d,0x00,0x00,0x00,0xc1,0xff,0xef,0xcb,0xff,0xff,0x05,0x00,0x00,0xf9,0xdf,0x04,
+  0x00,0xa2,0xff,0x2e,0x00,0x20,0xff,0x2e,0x00,0x00,0x00,0xfb,0x8f,0x00,0x80,0xff,
+  0x06,0x00,0x00,0x00,0xf4,0xcf,0x00,0xb0,0xef,0x01,0x00,0x00,0x00,0xf2,0xdf,0x00,
+  0x00,0x11,0x00,0x00,0x00,0x00,0xf2,0xdf,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xf5,
+  0xaf,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfa,0x6f,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x30,0xff,0x1d,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xff,0x05,0x00,0x00,0x00,0x00,
+  0x00,0x00,0xfa,0x9f,0x00,0x00,0x00,0x00,0x00,0x00,0x90,0xff,0x0b,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xf8,0xbf,0x01,0x00,0x00,0x00,0x00,0x00,0x80,0xff,0x1c,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xf8,0xcf,0x01,0x00,0x00,0x00,0x00,0x00,0x80,0xff,0x1c,0x00,
+  0x00,0x00,0x00,0x00,0x00,0xf8,0xcf,0x01,0x00,0x00,0x00,0x00,0x00,0x80,0xff,0x1d,
+  0x00,0x00,0x00,0x00,0x00,0x00,0xf8,0xdf,0x01,0x00,0x00,0x00,0x00,0x00,0x80,0xff,
+  0xaf,0xbb,0xbb,0xbb,0xbb,0xbb,0x02,0xf3,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x05,
+  0xf4,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x05,0x00,0x00,0x10,0x95,0xbb,0x6a,0x01,
+  0x00,0x00,0x00,0x00,0xe6,0xff,0xff,0xff,0x8f,0x00,0x00,0x00,0x80,0xff,0xef,0xcc,
+  0xfe,0xff,0x0a,0x00,0x00,0xf4,0xff,0x17,0x00,0x70,0xff,0x5f,0x00,0x00,0xfd,0x5f,
+  0x00,0x00,0x00,0xf7,0xbf,0x00,0x30,0xff,0x0b,0x00,0x00,0x00,0xf1,0xef,0x00,0x60,
+  0xff,0x05,0x00,0x00,0x00,0xd0,0xff,0x00,0x00,0x21,0x00,0x00,0x00,0x00,0xe0,0xdf,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xf3,0x9f,0x00,0x00,0x00,0x00,0x00,0x00,0x10,
+  0xfc,0x2e,0x00,0x00,0x00,0x00,0x10,0x42,0xe8,0xef,0x04,0x00,0x00,0x00,0x00,0x60,
+  0xff,0xff,0x19,0x00,0x00,0x00,0x00,0x00,0x60,0xff,0xff,0xbf,0x03,0x00,0x00,0x00,
+  0x00,0x00,0x20,0xa5,0xff,0x3e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xf5,0xdf,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0xb0,0xff,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x70,
+  0xff,0x07,0x30,0x37,0x00,0x00,0x00,0x00,0x60,0xff,0x08,0xf1,0xdf,0x00,0x00,0x00,
+  0x00,0x90,0xff,0x06,0xb0,0xff,0x06,0x00,0x00,0x00,0xe1,0xff,0x03,0x40,0xff,0x4f,
+  0x00,0x00,0x10,0xfb,0xbf,0x00,0x00,0xf9,0xff,0x5a,0x44,0xe8,0xff,0x2e,0x00,0x00,
+  0xa0,0xff,0xff,0xff,0xff,0xdf,0x03,0x00,0x00,0x00,0xc5,0xff,0xff,0xdf,0x17,0x00,
+  0x00,0x00,0x00,0x00,0x31,0x44,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,
+  0x87,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xa0,0xff,0x0c,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xf6,0xff,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0xff,0xff,0x0c,
+  0x00,0x00,0x00,0x00,0x00,0x00,0xd1,0xdf,0xfc,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,
+  0xfa,0x3f,0xfc,0x0c,0x00,0x00,0x00,0x00,0x00,0x60,0xff,0x07,0xfc,0x0c,0x00,0x00,
+  0x00,0x00,0x00,0xf3,0xbf,0x00,0xfc,0x0c,0x00,0x00,0x00,0x00,0x10,0xfd,0x1d,0x00,
+  0xfc,0x0c,0x00,0x00,0x00,0x00,0xa0,0xff,0x04,0x00,0xfc,0x0c,0x00,0x00,0x00,0x00,
+  0xf7,0x8f,0x00,0x00,0xfc,0x0c,0x00,0x00,0x00,0x30,0xff,0x0b,0x00,0x00,0xfc,0x0c,
+  0x00,0x00,0x00,0xd1,0xef,0x02,0x00,0x00,0xfc,0x0c,0x00,0x00,0x00,0xfa,0x5f,0x00,
+  0x00,0x00,0xfc,0x0c,0x00,0x00,0x70,0xff,0x09,0x00,0x00,0x00,0xfc,0x0c,0x00,0x00,
+  0xf3,0xff,0x88,0x88,0x88,0x88,0xfd,0x8d,0x88,0x03,0xf3,0xff,0xff,0xff,0xff,0xff,
+  0xff,0xff,0xff,0x05,0xb0,0xdd,0xdd,0xdd,0xdd,0xdd,0xff,0xdf,0xdd,0x03,0x00,0x00,
+  0x00,0x00,0x00,0x00,0xfc,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0x0c,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0xfc,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0x0c,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0x0c,0x00,0x00,0x00,0x10,0x88,0x88,0x88,0x88,
+  0x88,0x08,0x00,0x40,0xff,0xff,0xff,0xff,0xff,0x0f,0x00,0x70,0xff,0xff,0xff,0xff,
+  0xff,0x0c,0x00,0x90,0xdf,0x44,0x44,0x44,0x34,0x00,0x00,0xc0,0xbf,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xe0,0x8f,0x00,0x00,0x00,0x00,0x00,0x00,0xf2,0x5f,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xf5,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0xf7,0x0f,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xfa,0xbe,0xfd,0xef,0x7b,0x01,0x00,0x00,0xfc,0xff,0xff,0xff,0xff,
+  0x4e,0x00,0x00,0xe9,0x9d,0x68,0xa7,0xfe,0xff,0x04,0x00,0x00,0x00,0x00,0x00,0xb1,
+  0xff,0x0d,0x00,0x00,0x00,0x00,0x00,0x10,0xfd,0x5f,0x00,0x00,0x00,0x00,0x00,0x00,
+  0xf7,0x9f,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xbf,0x00,0x00,0x00,0x00,0x00,0x00,
+  0xf3,0xbf,0x00,0x00,0x00,0x00,0x00,0x00,0xf5,0xaf,0x00,0x00,0x00,0x00,0x00,0x00,
+  0xf9,0x6f,0x00,0x00,0x00,0x00,0x00,0x20,0xfe,0x1f,0x40,0x7c,0x00,0x00,0x00,0xd2,
+  0xff,0x08,0xe1,0xff,0x8d,0x45,0x95,0xfe,0xcf,0x00,0x50,0xfe,0xff,0xff,0xff,0xff,
+  0x1a,0x00,0x00,0x71,0xfd,0xff,0xff,0x4b,0x00,0x00,0x00,0x00,0x10,0x44,0x13,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x85,0x48,0x00,0x00,0x00,0x00,0x00,0x00,0x90,
+  0xff,0x1d,0x00,0x00,0x00,0x00,0x00,0x00,0xf5,0xff,0x03,0x00,0x00,0x00,0x00,0x00,
+  0x20,0xfe,0x6f,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xff,0x09,0x00,0x00,0x00,0x00,
+  0x00,0x00,0xf9,0xcf,0x00,0x00,0x00,0x00,0x00,0x00,0x50,0xff,0x2e,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xe2,0xff,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0x7f,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x80,0xff,0x1a,0x65,0x25,0x00,0x00,0x00,0x00,0xf4,0xef,0xfb,
+  0xff,0xff,0x5d,0x00,0x00,0x00,0xfc,0xff,0xef,0xed,0xff,0xff,0x08,0x00,0x50,0xff,
+  0xcf,0x04,0x00,0x92,0xff,0x6f,0x00,0xb0,0xff,0x1c,0x00,0x00,0x00,0xf7,0xef,0x01,
+  0xf1,0xff,0x02,0x00,0x00,0x00,0xc0,0xff,0x05,0xf3,0xbf,0x00,0x00,0x00,0x00,0x70,
+  0xff,0x08,0xf3,0x9f,0x00,0x00,0x00,0x00,0x50,0xff,0x09,0xf2,0xaf,0x00,0x00,0x00,
+  0x00,0x60,0xff,0x08,0xe0,0xcf,0x00,0x00,0x00,0x00,0x90,0xff,0x06,0xa0,0xff,0x03,
+  0x00,0x00,0x00,0xe2,0xff,0x01,0x40,0xff,0x2d,0x00,0x00,0x10,0xfc,0x8f,0x00,0x00,
+  0xf9,0xef,0x48,0x42,0xe8,0xff,0x1c,0x00,0x00,0x90,0xff,0xff,0xff,0xff,0xbf,0x01,
+  0x00,0x00,0x00,0xb4,0xff,0xff,0xcf,0x05,0x00,0x00,0x00,0x00,0x00,0x31,0x34,0x01,
+  0x00,0x00,0x00,0x81,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x06,0xf3,0xff,0xff,0xff,
+  0xff,0xff,0xff,0xff,0x0b,0xf2,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x0a,0x30,0x44,
+  0x44,0x44,0x44,0x44,0xa4,0xff,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0xe2,0xcf,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0xf9,0x5f,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0xff,
+  0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x90,0xff,0x05,0x00,0x00,0x00,0x00,0x00,0x00,
+  0xf2,0xcf,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfa,0x5f,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x20,0xff,0x0d,0x00,0x00,0x00,0x00,0x00,0x00,0xa0,0xff,0x05,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xf3,0xdf,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfa,0x5f,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x30,0xff,0x0d,0x00,0x00,0x00,0x00,0x00,0x00,0xa0,0xff,0x05,
+  0x00,0x00,0x00,0x00,0x00,0x00,0xf3,0xdf,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfb,
+  0x6f,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0xff,0x0d,0x00,0x00,0x00,0x00,0x00,0x00,
+  0xb0,0xff,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0xf4,0xdf,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0xfb,0x6f,0x00,0x00,0x00,0x00,0x00,0x00,0x40,0xff,0x0d,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xb0,0xef,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0xa8,0xab,
+  0x38,0x00,0x00,0x00,0x00,0x20,0xfb,0xff,0xff,0xff,0x2b,0x00,0x00,0x00,0xe2,0xff,
+  0x9d,0x98,0xfd,0xef,0x02,0x00,0x00,0xfc,0x8f,0x00,0x00,0x90,0xff,0x0c,0x00,0x40,
+  0xff,0x0b,0x00,0x00,0x00,0xfb,0x4f,0x00,0x80,0xff,0x05,0x00,0x00,0x00,0xf6,0x7f,
+  0x00,0x90,0xff,0x04,0x00,0x00,0x00,0xf4,0x9f,0x00,0x80,0xff,0x05,0x00,0x00,0x00,
+  0xf6,0x7f,0x00,0x40,0xff,0x0a,0x00,0x00,0x00,0xfa,0x3f,0x00,0x00,0xfc,0x6f,0x00,
+  0x00,0x60,0xff,0x0b,0x00,0x00,0xd2,0xff,0x6b,0x66,0xfb,0xcf,0x01,0x00,0x00,0x10,
+  0xf8,0xff,0xff,0xff,0x08,0x00,0x00,0x00,0x91,0xff,0xff,0xff,0xff,0x8e,0x01,0x00,
+  0x10,0xfd,0xcf,0x15,0x10,0xc5,0xff,0x1c,0x00,0xa0,0xff,0x09,0x00,0x00,0x00,0xfa,
+  0xaf,0x00,0xf2,0xef,0x01,0x00,0x00,0x00,0xe1,0xff,0x01,0xf5,0xaf,0x00,0x00,0x00,
+  0x00,0xb0,0xff,0x05,0xf6,0x9f,0x00,0x00,0x00,0x00,0x90,0xff,0x06,0xf5,0xaf,0x00,
+  0x00,0x00,0x00,0xb0,0xff,0x05,0xf2,0xef,0x01,0x00,0x00,0x00,0xe1,0xff,0x02,0xc0,
+  0xff,0x0a,0x00,0x00,0x00,0xfb,0xbf,0x00,0x30,0xfe,0xcf,0x26,0x22,0xd6,0xff,0x2e,
+  0x00,0x00,0xe4,0xff,0xff,0xff,0xff,0xdf,0x03,0x00,0x00,0x10,0xd7,0xff,0xff,0xdf,
+  0x17,0x00,0x00,0x00,0x00,0x00,0x31,0x34,0x01,0x00,0x00,0x00,0x00,0x00,0x50,0xb9,
+  0xab,0x16,0x00,0x00,0x00,0x50,0xfd,0xff,0xff,0xff,0x08,0x00,0x00,0xf7,0xff,0xbe,
+  0xdb,0xff,0xaf,0x00,0x50,0xff,0x6e,0x00,0x00,0xd4,0xff,0x07,0xd0,0xff,0x04,0x00,
+  0x00,0x20,0xfe,0x1e,0xf4,0xbf,0x00,0x00,0x00,0x00,0xf8,0x5f,0xf7,0x6f,0x00,0x00,
+  0x00,0x00,0xf4,0x8f,0xf8,0x5f,0x00,0x00,0x00,0x00,0xf2,0xaf,0xf8,0x7f,0x00,0x00,
+  0x00,0x00,0xf4,0x9f,0xf5,0xbf,0x00,0x00,0x00,0x00,0xf9,0x8f,0xe1,0xff,0x04,0x00,
+  0x00,0x40,0xff,0x4f,0x80,0xff,0x7e,0x01,0x10,0xf7,0xff,0x0e,0x00,0xfa,0xff,0xdf,
+  0xfd,0xff,0xff,0x07,0x00,0x70,0xfe,0xff,0xef,0xe9,0xdf,0x01,0x00,0x00,0x30,0x55,
+  0x03,0xfb,0x4f,0x00,0x00,0x00,0x00,0x00,0x70,0xff,0x09,0x00,0x00,0x00,0x00,0x00,
+  0xf4,0xdf,0x01,0x00,0x00,0x00,0x00,0x20,0xfe,0x4f,0x00,0x00,0x00,0x00,0x00,0xc0,
+  0xff,0x08,0x00,0x00,0x00,0x00,0x00,0xf8,0xcf,0x00,0x00,0x00,0x00,0x00,0x50,0xff,
+  0x3f,0x00,0x00,0x00,0x00,0x00,0xe2,0xff,0x07,0x00,0x00,0x00,0x00,0x00,0xfc,0xbf,
+  0x00,0x00,0x00,0x00,0x00,0x90,0xff,0x2c,0x00,0x00,0x00,0x00,0x10,0x01,0x00,0xf5,
+  0x8f,0x00,0xfd,0xff,0x02,0xfc,0xff,0x01,0xc3,0x6e,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0xb2,0x5c,0x00,0xfb,0xef,0x01,0xfd,0xff,0x02,0xf6,0xaf,0x00,0x20,
+  0x03,0x00,
+};
+
+inline constexpr AaFont kLato24 = {kLato24Index, kLato24Glyphs, kLato24Bitmaps, 25, 24};
+
+}  // namespace fonts
+}  // namespace graphics
@@ -1,39 +1,107 @@
 #pragma once
 
 #include <Arduino.h>
-#include <SPI.h>
 
 #include "graphics.h"
+#include "graphics_utils.h"
+#include "raster_graphics.h"
+#include "spi_dma_bus.h"
+
+namespace render_bench {
+struct PanelAccess;
+}  // namespace render_bench
 
 namespace graphics {
 
-class Gc9a01Graphics : public Graphics {
+// Format of pixels on the SPI bus. The drawing API is RGB565 either way.
+enum class PixelFormat : uint8_t {
+  Rgb565,
+  Rgb444,
+};
+
+class Gc9a01Graphics final : public RasterGraphics<Gc9a01Graphics> {
  public:
+  // Logical rotation that matches the panel's scan direction. Pixels in
+  // panel space are laid out as if drawn at this rotation.
+  static constexpr uint8_t kPanelRotation = 1;
+
   Gc9a01Graphics(uint8_t pin_dc,
                  uint8_t pin_cs,
                  uint8_t pin_rst,
                  bool ips = true);
+  ~Gc9a01Graphics() override;
 
   bool begin(uint32_t freq_hz);
 
-  void fillScreen(uint16_t color) override;
-  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
-  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  // When enabled, primitives rasterize into a 240x240 RGB565 buffer in
+  // internal RAM and only reach the panel on flush().
+  bool setFramebufferEnabled(bool enabled);
+  bool framebufferEnabled() const { return framebuffer_ != nullptr; }
+
+  // Keeps a copy of the last frame sent (115 KB of PSRAM) so flush()
+  // compares dirty rows against it and sends only the pixels that changed.
+  // Needs the framebuffer and goes away with it; false without PSRAM.
+  bool setFrameDiffEnabled(bool enabled);
+  bool frameDiffEnabled() const { return shown_ != nullptr; }
+
+  // Keeps two 240x24 band buffers (about 23 KB) so that renderBanded() can
+  // produce full frames without a framebuffer. Ignored while one exists.
+  bool setBandedRenderingEnabled(bool enabled);
+  bool bandedRenderingEnabled() const { return bands_[0] != nullptr; }
+
+  // Draws a complete frame. With bands enabled, `scene` is replayed once
+  // per band and must paint every pixel; otherwise it runs once as usual.
+  // It gets the driver itself, so the scene's calls bind at compile time.
+  using SceneFn = void (*)(Gc9a01Graphics &display, void *context);
+  void renderBanded(SceneFn scene, void *context);
+
+  // Rgb444 sends two pixels in three bytes, a quarter less traffic for
+  // palettes that survive the lost low bits. Safe to change at any time.
+  void setPixelFormat(PixelFormat format);
+  PixelFormat pixelFormat() const { return pixelFormat_; }
+
+  // Limits fills and framebuffer flushes to the circle the round glass
+  // shows; corner pixels are neither written nor sent.
+  void setRoundClipEnabled(bool enabled) { roundClip_ = enabled; }
+  bool roundClipEnabled() const { return roundClip_; }
+
+  // Pieces are collected in panel space, sorted by row and merged where
+  // they touch, then sent with one address window per merged rect.
+  void fillSpans(const Span *spans, uint16_t count, uint16_t color) override;
+  void fillRects(const Rect *rects, uint16_t count, uint16_t color) override;
+  void drawPolyline(const Point *points, uint8_t count, uint8_t width, uint16_t color) override;
   void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
-  void fillTriangle(int16_t x0, int16_t y0,
-                    int16_t x1, int16_t y1,
-                    int16_t x2, int16_t y2,
-                    uint16_t color) override;
-  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) override;
+
   void fillSpan(int16_t x0, int16_t x1, int16_t y, uint16_t color);
 
   uint8_t getRotation() const override;
   void setRotation(uint8_t rotation) override;
 
-  void drawText(int16_t x, int16_t y,
-                const char *text,
-                uint16_t colorText, uint16_t colorBG,
-                uint8_t textSize) override;
+  // Kept in panel space and applied to each panel rect, text box and row
+  // block before it is written or sent; framebuffer flushes are not
+  // clipped.
+  void pushClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) override;
+  void popClip() override;
+
+  void drawTextBox(int16_t x, int16_t y, int16_t w, int16_t h,
+                   int16_t textX, int16_t textY,
+                   const char *text,
+                   uint16_t colorText, uint16_t colorBG,
+                   uint8_t textSize) override;
+
+  void drawRows(int16_t x, int16_t y, int16_t w, int16_t h, RowSource source, void *context) override;
+
+  void flush() override;
+
+  // Streams the panel-space rect row by row, bypassing any framebuffer.
+  // `source` writes wire-order RGB565 for columns x0..x1 of panel row `y`;
+  // the round clip and the bus pixel format are applied here.
+  void pushRows(int16_t x0, int16_t y0, int16_t x1, int16_t y1, RowSource source, void *context);
+
+  const TransferStats &transferStats() const { return bus_.stats(); }
+  void resetTransferStats() { bus_.resetStats(); }
+  // Blocks until everything queued so far has left the SPI peripheral.
+  void waitForTransfers();
 
   int16_t width() const override { return width_; }
   int16_t height() const override { return height_; }
@@ -42,35 +110,88 @@ class Gc9a01Graphics : public Graphics {
   void displayOff() override;
 
  private:
+  friend class RasterGraphics<Gc9a01Graphics>;
+  // Times drawPixel, which is not part of the drawing API.
+  friend struct render_bench::PanelAccess;
+
+  struct DirtyRect {
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+  };
+  static constexpr uint8_t kMaxDirtyRects = 8;
+  static constexpr uint8_t kMaxBatchRects = 64;
+
+  // Feeds the raster:: walkers into the batch being collected.
+  struct BatchSink {
+    Gc9a01Graphics &gfx;
+    void hspan(int16_t x0, int16_t x1, int16_t y) { gfx.batchLogicalRect(x0, y, x1, y); }
+    void vspan(int16_t x, int16_t y0, int16_t y1) { gfx.batchLogicalRect(x, y0, x, y1); }
+  };
+
   void hardwareReset();
   void initPanel();
-  void startWrite();
-  void endWrite();
   void writeCommand(uint8_t cmd);
   void writeCommandWithData(uint8_t cmd, const uint8_t *data, size_t len);
-  void writeData(const uint8_t *data, size_t len);
-  void writeData16(uint16_t value);
   void writeData16Repeat(uint16_t value, size_t count);
   void setAddrWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  uint16_t paintFor(uint16_t color) const { return color; }
+  void fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    fillLogicalRect(x0, y0, x1, y1, color);
+  }
+  // Logical coordinates are clipped and turned into panel space here.
+  void fillLogicalRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void fillPanelRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
-  void pushPixels(const uint16_t *pixels, size_t count);
-  void fillSpanInternal(int16_t x0, int16_t x1, int16_t y, uint16_t color);
-  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
-  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
-  void drawChar(int16_t x, int16_t y, char c,
-                uint16_t colorText, uint16_t colorBG,
-                uint8_t textSize);
-
-  SPIClass spi_;
-  SPISettings spi_settings_;
+  void markDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  // Clips a logical rect and adds it to the batch in batchColor_, sending
+  // the batch first when it is full.
+  void batchLogicalRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  void sendBatch();
+  void awaitFramebuffer();
+  void sendFramebufferRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  // Sends the parts of a framebuffer rect that differ from shown_ and
+  // brings shown_ up to date.
+  void sendChangedRows(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  int16_t stagedRowsPerBuffer(int16_t pitch) const;
+  // Sends wire-order RGB565 pixels held in the active staging buffer.
+  void submitStagedPixels(uint16_t *pixels, size_t count);
+  void sendFramebufferRect444(const uint16_t *row, int16_t width, int16_t height);
+
+  SpiDmaBus bus_;
   uint8_t dc_;
   uint8_t cs_;
   uint8_t rst_;
   bool ips_;
   uint8_t rotation_ = 0;
+  // Clockwise quarter turns from logical to panel coordinates.
+  uint8_t panelTurns_ = 0;
+  ClipStack clips_{240};
   int16_t width_ = 240;
   int16_t height_ = 240;
   bool initialized_ = false;
+  uint16_t *framebuffer_ = nullptr;
+  // Where pixel writes land: the framebuffer, the band being rendered or
+  // nothing (direct drawing). It holds panel rows targetTop_..targetBottom_.
+  uint16_t *target_ = nullptr;
+  int16_t targetTop_ = 0;
+  int16_t targetBottom_ = 239;
+  uint16_t *bands_[2] = {nullptr, nullptr};
+  uint32_t bandSeq_[2] = {0, 0};
+  // The frame as last sent, for frame diffing; only trusted once shownValid_.
+  uint16_t *shown_ = nullptr;
+  bool shownValid_ = false;
+  DirtyRect dirty_[kMaxDirtyRects];
+  uint8_t dirtyCount_ = 0;
+  // Panel rects of the fillSpans/fillRects/drawPolyline/drawLine call in
+  // progress.
+  DirtyRect batch_[kMaxBatchRects];
+  uint8_t batchCount_ = 0;
+  uint16_t batchColor_ = 0;
+  bool framebufferInFlight_ = false;
+  bool roundClip_ = false;
+  PixelFormat pixelFormat_ = PixelFormat::Rgb565;
 };
 
 }  // namespace graphics
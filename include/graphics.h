@@ -4,6 +4,35 @@
 
 namespace graphics {
 
+struct Point {
+  int16_t x;
+  int16_t y;
+};
+
+// Pixels x0..x1 of row y, inclusive.
+struct Span {
+  int16_t x0;
+  int16_t x1;
+  int16_t y;
+};
+
+// Same origin and size convention as fillRect.
+struct Rect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+// Supplies colors for columns x0..x1 of row y, one per entry of `dest`.
+using RowSource = void (*)(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest);
+
+struct TransferStats {
+  uint32_t bytes = 0;
+  uint32_t transactions = 0;
+  uint32_t windows = 0;
+};
+
 class Graphics {
  public:
   virtual ~Graphics() = default;
@@ -18,17 +47,58 @@ class Graphics {
     int16_t x2, int16_t y2,
     uint16_t color
   ) = 0;
+  // Convex polygons only, up to raster::kMaxPolygonVertices points. Points
+  // name pixel centers; right and bottom edges are exclusive.
+  virtual void fillPolygon(const Point *points, uint8_t count, uint16_t color) = 0;
+  virtual void drawWideLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, uint16_t color) = 0;
   virtual void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) = 0;
+  // Pixels with rInner < distance <= rOuter; rInner < 0 gives a full disc.
+  virtual void fillRing(int16_t x0, int16_t y0, int16_t rOuter, int16_t rInner, uint16_t color) = 0;
+  // Clockwise slice of a ring, degrees from the +x axis (3 o'clock).
+  virtual void fillArc(int16_t x0, int16_t y0, int16_t rOuter, int16_t rInner,
+                       int16_t startDeg, int16_t endDeg, uint16_t color) = 0;
+
+  // Batches of one color in any order; overlaps are allowed. One call
+  // replaces a call per piece, and backends may reorder and merge pieces.
+  virtual void fillSpans(const Span *spans, uint16_t count, uint16_t color) = 0;
+  virtual void fillRects(const Rect *rects, uint16_t count, uint16_t color) = 0;
+  // Segments joining consecutive points, each as drawWideLine draws it, or
+  // as drawLine for width 1.
+  virtual void drawPolyline(const Point *points, uint8_t count, uint8_t width, uint16_t color) = 0;
 
   virtual uint8_t getRotation() const = 0;
   virtual void setRotation(uint8_t rotation) = 0;
 
+  // Limits drawing to the inclusive rect, intersected with the clip already
+  // in force, until the matching popClip(). The rect is taken at the current
+  // rotation and stays on the same pixels if the rotation changes. Every
+  // primitive is clipped span by span or box by box before it reaches
+  // memory or the bus, so clipped-away pixels are neither written, sent nor
+  // read from a RowSource.
+  virtual void pushClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) = 0;
+  virtual void popClip() = 0;
+
   virtual void drawText(
     int16_t x, int16_t y,
     const char *text,
     uint16_t colorText, uint16_t colorBG,
     uint8_t textSize
   ) = 0;
+  // Paints the box in colorBG with the first line of `text` at (textX, textY)
+  // clipped to it. Every pixel of the box is written exactly once.
+  virtual void drawTextBox(
+    int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t textX, int16_t textY,
+    const char *text,
+    uint16_t colorText, uint16_t colorBG,
+    uint8_t textSize
+  ) = 0;
+
+  // Copies a w x h block of RGB565 pixels that `source` produces row by
+  // row, top to bottom. Rows are requested only for the visible part.
+  virtual void drawRows(int16_t x, int16_t y, int16_t w, int16_t h, RowSource source, void *context) = 0;
+
+  virtual void flush() = 0;
 
   virtual int16_t width() const = 0;
   virtual int16_t height() const = 0;
@@ -1,14 +1,96 @@
 #pragma once
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #include "graphics.h"
 
 namespace graphics {
 
+// Turns (x, y) clockwise by `turns` quarter turns inside a size x size
+// square. Display rotation is applied in software with these.
+inline void rotatePoint(int16_t &x, int16_t &y, uint8_t turns, int16_t size) {
+  const int16_t max = size - 1;
+  const int16_t x0 = x;
+  switch (turns & 3) {
+    case 1:
+      x = max - y;
+      y = x0;
+      break;
+    case 2:
+      x = max - x;
+      y = max - y;
+      break;
+    case 3:
+      x = y;
+      y = max - x0;
+      break;
+    default:
+      break;
+  }
+}
+
+inline void rotateRect(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1, uint8_t turns, int16_t size) {
+  rotatePoint(x0, y0, turns, size);
+  rotatePoint(x1, y1, turns, size);
+  if (x0 > x1) std::swap(x0, x1);
+  if (y0 > y1) std::swap(y0, y1);
+}
+
+// Buffer step taken by one logical +x pixel, for a row pitch of `pitch`.
+inline ptrdiff_t rotatedStride(uint8_t turns, ptrdiff_t pitch) {
+  switch (turns & 3) {
+    case 1: return pitch;
+    case 2: return -1;
+    case 3: return -pitch;
+    default: return 1;
+  }
+}
+
+// Sink for the raster:: walkers that hands their runs to fillRects() a
+// buffer at a time, so a whole shape or set of shapes costs a few calls.
+// Like the scopes below it takes the display's own type, so the calls bind
+// at compile time for a concrete backend.
+template <typename Display = Graphics>
+class RectBatch {
+ public:
+  RectBatch(Display &display, uint16_t color) : display_(display), color_(color) {}
+
+  RectBatch(const RectBatch &) = delete;
+  RectBatch &operator=(const RectBatch &) = delete;
+
+  ~RectBatch() { flush(); }
+
+  void hspan(int16_t x0, int16_t x1, int16_t y) { add(Rect{x0, y, static_cast<int16_t>(x1 - x0 + 1), 1}); }
+  void vspan(int16_t x, int16_t y0, int16_t y1) { add(Rect{x, y0, 1, static_cast<int16_t>(y1 - y0 + 1)}); }
+
+  void flush() {
+    if (count_ == 0) return;
+    display_.fillRects(rects_, count_, color_);
+    count_ = 0;
+  }
+
+ private:
+  static constexpr uint16_t kCapacity = 64;
+
+  void add(const Rect &rect) {
+    rects_[count_++] = rect;
+    if (count_ == kCapacity) flush();
+  }
+
+  Display &display_;
+  uint16_t color_;
+  Rect rects_[kCapacity];
+  uint16_t count_ = 0;
+};
+
+template <typename Display = Graphics>
 class RotationScopeCW {
  public:
-  explicit RotationScopeCW(Graphics &display, uint8_t steps = 1)
+  explicit RotationScopeCW(Display &display, uint8_t steps = 1)
       : display_(display), previous_(display.getRotation()) {
     uint8_t target = static_cast<uint8_t>((previous_ + steps) % 4);
     display_.setRotation(target);
@@ -20,9 +102,142 @@ class RotationScopeCW {
   ~RotationScopeCW() { display_.setRotation(previous_); }
 
  private:
-  Graphics &display_;
+  Display &display_;
   uint8_t previous_;
 };
 
+// Adds an inclusive rect (anything with x0, y0, x1, y1) to a list of dirty
+// rects holding `count` of `Capacity`. It merges with an entry when their
+// union covers at most `Slack` pixels more than the two apart, and the
+// result is offered to the list again. When the list is full, it is folded
+// into whichever entry grows the least.
+template <int32_t Slack, typename DirtyRect, size_t Capacity>
+void addMergedRect(DirtyRect (&rects)[Capacity], uint8_t &count, DirtyRect incoming) {
+  auto area = [](const DirtyRect &r) -> int32_t {
+    return static_cast<int32_t>(r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1);
+  };
+  auto unite = [](const DirtyRect &a, const DirtyRect &b) -> DirtyRect {
+    return {std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1)};
+  };
+
+  while (true) {
+    bool merged = false;
+    for (uint8_t i = 0; i < count; ++i) {
+      const DirtyRect joined = unite(rects[i], incoming);
+      if (area(joined) <= area(rects[i]) + area(incoming) + Slack) {
+        incoming = joined;
+        rects[i] = rects[--count];
+        merged = true;
+        break;
+      }
+    }
+    if (merged) continue;
+
+    if (count < Capacity) {
+      rects[count++] = incoming;
+      return;
+    }
+
+    uint8_t best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (uint8_t i = 0; i < count; ++i) {
+      const int32_t growth = area(unite(rects[i], incoming)) - area(rects[i]);
+      if (growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
+      }
+    }
+    incoming = unite(rects[best], incoming);
+    rects[best] = rects[--count];
+  }
+}
+
+// Nested clip rects for a backend's pushClip()/popClip(), kept in a fixed
+// frame of the backend's own (panel space, rotation 0) so a clip stays on
+// the same pixels when the rotation changes. Each level is the intersection
+// of the rect pushed and the level below; the bottom one is the whole
+// size x size surface.
+class ClipStack {
+ public:
+  // Pushes past this depth narrow the deepest level in place, so popping
+  // them leaves that narrower clip until the stack is back within it.
+  static constexpr uint8_t kMaxDepth = 8;
+
+  explicit ClipStack(int16_t size) : size_(size) {
+    levels_[0] = Level{0, 0, static_cast<int16_t>(size - 1), static_cast<int16_t>(size - 1)};
+  }
+
+  // Inclusive rect, in either corner order, `turns` clockwise quarter
+  // turns away from the stack's frame.
+  void push(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t turns) {
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    rotateRect(x0, y0, x1, y1, turns, size_);
+    const Level &below = top();
+    // May come out empty, which clips everything away.
+    const Level level{std::max(x0, below.x0), std::max(y0, below.y0), std::min(x1, below.x1), std::min(y1, below.y1)};
+    if (depth_ < UINT8_MAX) ++depth_;
+    levels_[std::min(depth_, kMaxDepth)] = level;
+  }
+
+  void pop() {
+    if (depth_ > 0) --depth_;
+  }
+
+  bool active() const { return depth_ > 0; }
+
+  // Intersects an ordered inclusive rect in the stack's frame with the
+  // clip; false when nothing is left.
+  bool clip(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1) const {
+    const Level &level = top();
+    x0 = std::max(x0, level.x0);
+    y0 = std::max(y0, level.y0);
+    x1 = std::min(x1, level.x1);
+    y1 = std::min(y1, level.y1);
+    return x0 <= x1 && y0 <= y1;
+  }
+
+  // The same for a rect `turns` away from the stack's frame, which is
+  // returned in its own frame.
+  bool clip(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1, uint8_t turns) const {
+    if (!active()) return true;
+    rotateRect(x0, y0, x1, y1, turns, size_);
+    if (!clip(x0, y0, x1, y1)) return false;
+    rotateRect(x0, y0, x1, y1, static_cast<uint8_t>((4 - turns) % 4), size_);
+    return true;
+  }
+
+ private:
+  struct Level {
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+  };
+
+  const Level &top() const { return levels_[std::min(depth_, kMaxDepth)]; }
+
+  int16_t size_;
+  uint8_t depth_ = 0;
+  Level levels_[kMaxDepth + 1];
+};
+
+// Clips `display` to an inclusive rect for the scope's lifetime.
+template <typename Display = Graphics>
+class ClipScope {
+ public:
+  ClipScope(Display &display, int16_t x0, int16_t y0, int16_t x1, int16_t y1) : display_(display) {
+    display_.pushClip(x0, y0, x1, y1);
+  }
+
+  ClipScope(const ClipScope &) = delete;
+  ClipScope &operator=(const ClipScope &) = delete;
+
+  ~ClipScope() { display_.popClip(); }
+
+ private:
+  Display &display_;
+};
+
 }  // namespace graphics
 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "graphics.h"
+
+namespace image_pack {
+
+// An image in the pack written by tools/image_pack.py, placed at (x, y).
+// Rows are run-length encoded RGB565 and decoded straight from mapped
+// flash into the display's line buffers; nothing is unpacked in RAM.
+struct Image {
+  int16_t x = 0;
+  int16_t y = 0;
+  uint16_t width = 0;
+  uint16_t height = 0;
+  // In flash: a u32 offset per row into `rows`, and the encoded rows.
+  const uint8_t *rowOffsets = nullptr;
+  const uint8_t *rows = nullptr;
+};
+
+// Maps the `images` flash partition; false when it is missing or holds no
+// valid pack, and every lookup then fails.
+bool begin();
+uint16_t count();
+
+// Looks an image up by index or by its file name without the extension.
+// Entries whose rows would not decode within the pack are rejected, so a
+// found image is always safe to read.
+bool imageAt(uint16_t index, Image &image);
+bool find(const char *name, Image &image);
+
+// Draws the image at its (x, y) through Graphics::drawRows. The image is
+// read when the rows are, so it must stay valid until the frame is
+// flushed: recorded frames decode it on replay.
+void drawImage(graphics::Graphics &display, const Image &image);
+
+// Decodes the whole image into `dest`, width * height pixels row by row,
+// for code that needs random access such as the sprite rotator.
+void unpack(const Image &image, uint16_t *dest);
+
+// A RowSource over an Image (passed as `context`) in screen coordinates.
+void readRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest);
+
+}  // namespace image_pack
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "graphics.h"
+#include "graphics_utils.h"
+#include "raster_graphics.h"
+
+namespace graphics {
+
+class Gc9a01Graphics;
+
+// Off-screen 240x240 canvas that stores palette indices instead of RGB565:
+// 28.8 KB at 4 bpp or 57.6 KB at 8 bpp against 115 KB for a full frame.
+// Drawing colors are assigned palette entries as they are first used and
+// rows are expanded through the palette while flush() streams them out.
+class IndexedCanvas final : public RasterGraphics<IndexedCanvas> {
+ public:
+  // bitsPerPixel is 4 (16 colors) or 8 (256 colors).
+  IndexedCanvas(Gc9a01Graphics &panel, uint8_t bitsPerPixel);
+  // An off-screen layer: flush() and the display calls do nothing and the
+  // content is read back with readRow().
+  explicit IndexedCanvas(uint8_t bitsPerPixel);
+  ~IndexedCanvas() override;
+
+  IndexedCanvas(const IndexedCanvas &) = delete;
+  IndexedCanvas &operator=(const IndexedCanvas &) = delete;
+
+  // Allocates the index buffer; false when internal RAM is short.
+  bool begin();
+  uint8_t bitsPerPixel() const { return bits_; }
+
+  // Forgets every drawing color; index 0 is black, as is a fresh buffer.
+  void clearPalette();
+  // Changes how pixels drawn in `color` look on the next flush without
+  // redrawing them, e.g. for a night theme. False if `color` is unused.
+  bool setShownColor(uint16_t color, uint16_t shown);
+  // Shows every entry as drawn again.
+  void restoreShownColors();
+  // Sends the whole canvas on the next flush, e.g. after the panel reset.
+  void invalidate();
+
+  // A RowSource over the canvas (passed as `context`) that yields the
+  // drawing colors of a logical row, as with drawRows().
+  static void readRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest);
+
+  uint8_t getRotation() const override { return rotation_; }
+  void setRotation(uint8_t rotation) override;
+
+  // Kept in panel space like the index buffer itself.
+  void pushClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) override;
+  void popClip() override;
+
+  void drawTextBox(int16_t x, int16_t y, int16_t w, int16_t h,
+                   int16_t textX, int16_t textY,
+                   const char *text,
+                   uint16_t colorText, uint16_t colorBG,
+                   uint8_t textSize) override;
+
+  void drawRows(int16_t x, int16_t y, int16_t w, int16_t h, RowSource source, void *context) override;
+
+  void flush() override;
+
+  int16_t width() const override { return kSize; }
+  int16_t height() const override { return kSize; }
+
+  void displayOn() override;
+  void displayOff() override;
+
+ private:
+  static constexpr int16_t kSize = 240;
+
+  friend class RasterGraphics<IndexedCanvas>;
+
+  uint8_t indexFor(uint16_t color);
+  uint8_t paintFor(uint16_t color) { return indexFor(color); }
+  void fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t index) {
+    fillLogicalRect(x0, y0, x1, y1, index);
+  }
+  uint8_t indexAt(int16_t x, int16_t y) const;
+  void fillLogicalRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t index);
+  void fillPanelRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t index);
+  static void expandRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest);
+
+  Gc9a01Graphics *panel_;
+  uint8_t bits_;
+  size_t pitch_;
+  uint8_t *pixels_ = nullptr;
+  uint8_t rotation_;
+  // Clockwise quarter turns from logical to panel coordinates.
+  uint8_t panelTurns_ = 0;
+  ClipStack clips_{kSize};
+
+  uint16_t keys_[256];
+  // Colors actually sent for each index, in wire order.
+  uint16_t shown_[256];
+  uint16_t used_ = 0;
+
+  // Changed columns per panel row; a clean row has min > max.
+  uint8_t dirtyMin_[kSize];
+  uint8_t dirtyMax_[kSize];
+};
+
+}  // namespace graphics
@@ -5,9 +5,23 @@
 #include "graphics.h"
 #include "system_stats.h"
 
+namespace graphics {
+class Gc9a01Graphics;
+class IndexedCanvas;
+class RecordingGraphics;
+}  // namespace graphics
+
 namespace info_screen {
 
-void draw(graphics::Graphics &display, const system_stats::Stats &stats, const tm &currentTime, uint8_t batteryPercent, float batteryVoltage);
+// Takes the display as its own type, like watchface's draw calls, and is
+// instantiated in info_screen.cpp for the same types.
+template <typename Display>
+void draw(Display &display, const system_stats::Stats &stats, const tm &currentTime, uint8_t batteryPercent, float batteryVoltage);
+
+extern template void draw(graphics::Graphics &, const system_stats::Stats &, const tm &, uint8_t, float);
+extern template void draw(graphics::Gc9a01Graphics &, const system_stats::Stats &, const tm &, uint8_t, float);
+extern template void draw(graphics::RecordingGraphics &, const system_stats::Stats &, const tm &, uint8_t, float);
+extern template void draw(graphics::IndexedCanvas &, const system_stats::Stats &, const tm &, uint8_t, float);
 
 }  // namespace info_screen
 
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace graphics {
+namespace pixels {
+
+// Inner loops over pixel memory. Each kernel has a portable version in
+// `portable`, and the unqualified one dispatches to the fastest variant the
+// target has (the ESP32-S3's PIE vector unit where it helps). Every variant
+// writes exactly the same bytes, so callers never depend on which ran;
+// test/test_pixel_kernels checks the portable ones against plain loops.
+//
+// fill and swapBytes have PIE paths, built only with HACKTOR_PIE_KERNELS=1
+// (off by default until they are checked on hardware). The rest stay
+// word-wide scalar: the expanders are a table or bit lookup per pixel and
+// PIE has no gather, packRgb444 writes three bytes per pair, which no lane
+// width divides, and blend's scalar form already does one multiply per
+// pixel.
+
+// dest[0..count) = value.
+void fill(uint16_t *dest, uint16_t value, size_t count);
+
+// dest[i] = src[i] with its two bytes swapped, e.g. RGB565 to wire order
+// and back. dest may equal src.
+void swapBytes(uint16_t *dest, const uint16_t *src, size_t count);
+
+// dest[i] = lut[indices[i]], one index per byte.
+void expand8(uint16_t *dest, const uint8_t *indices, size_t count, const uint16_t *lut);
+
+// Same for two indices per byte, the even pixel in the low nibble, starting
+// at pixel `first` of `indices`.
+void expand4(uint16_t *dest, const uint8_t *indices, size_t first, size_t count, const uint16_t *lut);
+
+// Same for one bit per pixel, pixel i being bit i % 8 of byte i / 8: set
+// bits become `fg`, clear ones `bg`.
+void expand1(uint16_t *dest, const uint8_t *bits, size_t first, size_t count, uint16_t fg, uint16_t bg);
+
+// dest[i] = src[i] over dest[i] at `alpha` / 32, per RGB565 channel
+// d + floor((s - d) * alpha / 32). alpha is 0..32; 32 copies src.
+void blend(uint16_t *dest, const uint16_t *src, uint8_t alpha, size_t count);
+
+// Packs `pairs` pixel pairs of wire-order RGB565 into the panel's RGB444
+// stream, three bytes per pair; returns the bytes written. Writing never
+// overtakes reading, so dest may alias src.
+size_t packRgb444(uint8_t *dest, const uint16_t *src, size_t pairs);
+
+namespace portable {
+
+void fill(uint16_t *dest, uint16_t value, size_t count);
+void swapBytes(uint16_t *dest, const uint16_t *src, size_t count);
+void expand8(uint16_t *dest, const uint8_t *indices, size_t count, const uint16_t *lut);
+void expand4(uint16_t *dest, const uint8_t *indices, size_t first, size_t count, const uint16_t *lut);
+void expand1(uint16_t *dest, const uint8_t *bits, size_t first, size_t count, uint16_t fg, uint16_t bg);
+void blend(uint16_t *dest, const uint16_t *src, uint8_t alpha, size_t count);
+size_t packRgb444(uint8_t *dest, const uint16_t *src, size_t pairs);
+
+}  // namespace portable
+
+}  // namespace pixels
+}  // namespace graphics
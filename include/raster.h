@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include "graphics.h"
+
+namespace graphics {
+namespace raster {
+
+// Vertex in 28.4 fixed point. Integer coordinates name pixel centers, so
+// pixel (x, y) is the point (x * 16 + 8, y * 16 + 8).
+struct SubPoint {
+  int32_t x;
+  int32_t y;
+};
+
+constexpr uint8_t kMaxPolygonVertices = 8;
+
+inline SubPoint pixelCenter(int16_t x, int16_t y) {
+  return {static_cast<int32_t>(x) * 16 + 8, static_cast<int32_t>(y) * 16 + 8};
+}
+
+// Walks the same Bresenham path drawLine always used, but reports it as
+// maximal axis-aligned runs instead of pixels: sink.hspan(x0, x1, y) for
+// x-major lines and sink.vspan(x, y0, y1) for y-major ones (x0 <= x1,
+// y0 <= y1).
+template <typename Sink>
+void lineRuns(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Sink &&sink) {
+  const int16_t dx = std::abs(x1 - x0);
+  const int16_t sx = x0 < x1 ? 1 : -1;
+  const int16_t dy = -std::abs(y1 - y0);
+  const int16_t sy = y0 < y1 ? 1 : -1;
+  const bool xMajor = dx >= -dy;
+  int16_t err = dx + dy;
+
+  int16_t runX = x0;
+  int16_t runY = y0;
+  auto emit = [&](int16_t endX, int16_t endY) {
+    if (xMajor) {
+      sink.hspan(runX < endX ? runX : endX, runX < endX ? endX : runX, endY);
+    } else {
+      sink.vspan(endX, runY < endY ? runY : endY, runY < endY ? endY : runY);
+    }
+  };
+
+  while (x0 != x1 || y0 != y1) {
+    int16_t e2 = err * 2;
+    int16_t nx = x0;
+    int16_t ny = y0;
+    if (e2 >= dy) {
+      err += dy;
+      nx += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      ny += sy;
+    }
+    if (xMajor ? (ny != runY) : (nx != runX)) {
+      emit(x0, y0);
+      runX = nx;
+      runY = ny;
+    }
+    x0 = nx;
+    y0 = ny;
+  }
+  emit(x0, y0);
+}
+
+// Scanline fill of a convex polygon (either winding) as sink.hspan(x0, x1, y).
+// A pixel is covered when its center is inside; top and left edges are
+// inclusive, bottom and right ones exclusive, so polygons sharing an edge
+// never overlap. Edges are stepped incrementally as an integer part and a
+// remainder, like Bresenham, so each crossing is exact and the top-left
+// rule holds however close a pixel center lies to an edge: the only
+// divisions happen once per edge during setup.
+template <typename Sink>
+void convexPolygon(const SubPoint *points, uint8_t count, Sink &&sink) {
+  if (count < 3 || count > kMaxPolygonVertices) return;
+
+  // A crossing is x + rem / dy in 1/16 px, with 0 <= rem < dy.
+  struct Edge {
+    int16_t rowStart;  // first row whose center is on or below the top vertex
+    int16_t rowEnd;    // first row whose center is on or below the bottom vertex
+    int32_t x;         // whole part of the crossing with the current row center
+    int32_t rem;       // remainder of the crossing, in 1 / dy
+    int32_t dy;
+    int32_t step;      // whole part of the change per row
+    int32_t stepRem;   // remainder of the change per row, in 1 / dy
+  };
+  Edge edges[kMaxPolygonVertices];
+  uint8_t edgeCount = 0;
+  int16_t firstRow = INT16_MAX;
+  int16_t lastRow = INT16_MIN;
+
+  // Row r has its center at r * 16 + 8; ceil((y - 8) / 16) is the first one at or below y.
+  auto firstRowAtOrBelow = [](int32_t y) -> int16_t {
+    return static_cast<int16_t>((y - 8 + 15) >> 4);
+  };
+  // Floor division for a positive divisor.
+  auto floorDiv = [](int64_t num, int32_t den) -> int64_t {
+    const int64_t q = num / den;
+    return (num % den < 0) ? q - 1 : q;
+  };
+
+  for (uint8_t i = 0; i < count; ++i) {
+    SubPoint a = points[i];
+    SubPoint b = points[(i + 1) % count];
+    if (a.y == b.y) continue;
+    if (a.y > b.y) {
+      SubPoint t = a;
+      a = b;
+      b = t;
+    }
+    Edge &e = edges[edgeCount];
+    e.rowStart = firstRowAtOrBelow(a.y);
+    e.rowEnd = firstRowAtOrBelow(b.y);
+    if (e.rowStart >= e.rowEnd) continue;
+    e.dy = b.y - a.y;
+    const int64_t dx = b.x - a.x;
+    const int32_t firstCenter = e.rowStart * 16 + 8;
+    const int64_t num = static_cast<int64_t>(a.x) * e.dy + dx * (firstCenter - a.y);
+    e.x = static_cast<int32_t>(floorDiv(num, e.dy));
+    e.rem = static_cast<int32_t>(num - static_cast<int64_t>(e.x) * e.dy);
+    e.step = static_cast<int32_t>(floorDiv(dx * 16, e.dy));
+    e.stepRem = static_cast<int32_t>(dx * 16 - static_cast<int64_t>(e.step) * e.dy);
+    if (e.rowStart < firstRow) firstRow = e.rowStart;
+    if (e.rowEnd > lastRow) lastRow = e.rowEnd;
+    ++edgeCount;
+  }
+
+  for (int16_t row = firstRow; row < lastRow; ++row) {
+    // Crossings rounded up to 1/16 px: a center cx is at or right of a
+    // crossing exactly when it is at or right of its ceiling.
+    int32_t left = INT32_MAX;
+    int32_t right = INT32_MIN;
+    for (uint8_t i = 0; i < edgeCount; ++i) {
+      Edge &e = edges[i];
+      if (row < e.rowStart || row >= e.rowEnd) continue;
+      const int32_t ceilX = e.x + (e.rem != 0);
+      if (ceilX < left) left = ceilX;
+      if (ceilX > right) right = ceilX;
+      e.x += e.step;
+      e.rem += e.stepRem;
+      if (e.rem >= e.dy) {
+        e.rem -= e.dy;
+        ++e.x;
+      }
+    }
+    if (left > right) continue;
+    // Covered columns have centers in [left, right): x * 16 + 8 >= left, x * 16 + 8 < right.
+    const int16_t xa = static_cast<int16_t>((left - 8 + 15) >> 4);
+    const int16_t xb = static_cast<int16_t>((right - 9) >> 4);
+    if (xa <= xb) {
+      sink.hspan(xa, xb, row);
+    }
+  }
+}
+
+// A `width` pixel wide band around the segment, extended half a pixel past
+// both endpoints so the end pixels are covered like drawLine covers them.
+template <typename Sink>
+void wideLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, Sink &&sink) {
+  if (width == 0) return;
+  const SubPoint p0 = pixelCenter(x0, y0);
+  const SubPoint p1 = pixelCenter(x1, y1);
+  const float dx = static_cast<float>(x1 - x0);
+  const float dy = static_cast<float>(y1 - y0);
+  const float len = std::sqrt(dx * dx + dy * dy);
+  const float half = static_cast<float>(width) * 8.0f;  // half width in 1/16 px
+
+  float ux = 1.0f;
+  float uy = 0.0f;
+  if (len > 0.0f) {
+    ux = dx / len;
+    uy = dy / len;
+  }
+  const int32_t ex = static_cast<int32_t>(std::lround(ux * 8.0f));
+  const int32_t ey = static_cast<int32_t>(std::lround(uy * 8.0f));
+  const int32_t nx = static_cast<int32_t>(std::lround(-uy * half));
+  const int32_t ny = static_cast<int32_t>(std::lround(ux * half));
+
+  const SubPoint quad[4] = {
+    {p0.x - ex + nx, p0.y - ey + ny},
+    {p1.x + ex + nx, p1.y + ey + ny},
+    {p1.x + ex - nx, p1.y + ey - ny},
+    {p0.x - ex - nx, p0.y - ey - ny},
+  };
+  convexPolygon(quad, 4, sink);
+}
+
+// Segments between consecutive points: lineRuns for width 1, wideLine for
+// anything wider. A single point is drawn as a zero-length segment.
+template <typename Sink>
+void polyline(const Point *points, uint8_t count, uint8_t width, Sink &&sink) {
+  if (!points || count == 0 || width == 0) return;
+  for (uint8_t i = count > 1 ? 1 : 0; i < count; ++i) {
+    const Point &from = points[i > 0 ? i - 1 : 0];
+    const Point &to = points[i];
+    if (width > 1) {
+      wideLine(from.x, from.y, to.x, to.y, width, sink);
+    } else {
+      lineRuns(from.x, from.y, to.x, to.y, sink);
+    }
+  }
+}
+
+// Largest |dx| on row offset `dy` of the disc x^2 + y^2 <= r^2 + r, the
+// pixels whose centers lie within about r + 1/2 of the middle. This is not
+// the midpoint fillCircle's pixel set: at r = 1 it is a 3x3 square rather
+// than a plus, and at r = 6 it has 137 pixels to the midpoint's 129. Walks
+// inward from `start`, so callers sweeping |dy| upward pay O(r) in total.
+inline int16_t circleHalfWidth(int16_t r, int16_t dy, int16_t start) {
+  const int32_t limit = static_cast<int32_t>(r) * r + r;
+  const int32_t dy2 = static_cast<int32_t>(dy) * dy;
+  int16_t dx = start;
+  while (dx >= 0 && static_cast<int32_t>(dx) * dx + dy2 > limit) {
+    --dx;
+  }
+  return dx;
+}
+
+// Filled disc as exactly one sink.hspan per covered row.
+template <typename Sink>
+void disc(int16_t cx, int16_t cy, int16_t r, Sink &&sink) {
+  if (r < 0) return;
+  int16_t half = r;
+  for (int16_t dy = 0; dy <= r; ++dy) {
+    half = circleHalfWidth(r, dy, half);
+    sink.hspan(cx - half, cx + half, cy + dy);
+    if (dy != 0) {
+      sink.hspan(cx - half, cx + half, cy - dy);
+    }
+  }
+}
+
+namespace detail {
+
+struct Interval {
+  int16_t a;
+  int16_t b;
+};
+
+// Ring cover of one row offset as up to two disjoint intervals of dx.
+inline uint8_t ringIntervals(int16_t outerHalf, int16_t innerHalf, Interval out[2]) {
+  if (outerHalf < 0) return 0;
+  if (innerHalf < 0) {
+    out[0] = {static_cast<int16_t>(-outerHalf), outerHalf};
+    return 1;
+  }
+  if (innerHalf >= outerHalf) return 0;
+  out[0] = {static_cast<int16_t>(-outerHalf), static_cast<int16_t>(-innerHalf - 1)};
+  out[1] = {static_cast<int16_t>(innerHalf + 1), outerHalf};
+  return 2;
+}
+
+}  // namespace detail
+
+// Annulus rOuter >= d > rInner (same rounding as disc), one pass over the
+// rows with at most two spans per row and no pixel written twice.
+template <typename Sink>
+void ring(int16_t cx, int16_t cy, int16_t rOuter, int16_t rInner, Sink &&sink) {
+  if (rInner < 0) {
+    disc(cx, cy, rOuter, sink);
+    return;
+  }
+  int16_t outerHalf = rOuter;
+  int16_t innerHalf = rInner;
+  for (int16_t dy = 0; dy <= rOuter; ++dy) {
+    outerHalf = circleHalfWidth(rOuter, dy, outerHalf);
+    innerHalf = dy <= rInner ? circleHalfWidth(rInner, dy, innerHalf) : -1;
+    detail::Interval spans[2];
+    const uint8_t n = detail::ringIntervals(outerHalf, innerHalf, spans);
+    for (uint8_t i = 0; i < n; ++i) {
+      sink.hspan(cx + spans[i].a, cx + spans[i].b, cy + dy);
+      if (dy != 0) {
+        sink.hspan(cx + spans[i].a, cx + spans[i].b, cy - dy);
+      }
+    }
+  }
+}
+
+// Angular slice of an annulus. Angles are degrees measured clockwise on
+// screen from the +x axis (the watchface tick convention); the slice runs
+// clockwise from startDeg to endDeg. Each pixel is emitted at most once.
+template <typename Sink>
+void arc(int16_t cx, int16_t cy, int16_t rOuter, int16_t rInner,
+         int16_t startDeg, int16_t endDeg, Sink &&sink) {
+  int32_t sweep = (static_cast<int32_t>(endDeg) - startDeg) % 360;
+  if (sweep < 0) sweep += 360;
+  if (sweep == 0 && endDeg != startDeg) sweep = 360;
+  if (sweep == 0) return;
+  if (sweep >= 360) {
+    ring(cx, cy, rOuter, rInner, sink);
+    return;
+  }
+
+  // Each piece spans at most 180 degrees, which makes it the intersection of
+  // two half-planes through the center, each of the form c * dx <= s * dy.
+  // Their boundaries are kept as 16.16 slopes, so a row costs a multiply per
+  // boundary and no division.
+  struct HalfPlane {
+    int8_t sign;    // sign of c
+    int32_t s;
+    int64_t slope;  // s / c in 16.16
+  };
+  struct Piece {
+    HalfPlane start;
+    HalfPlane end;
+  };
+  auto makeHalfPlane = [](int32_t c, int32_t s) -> HalfPlane {
+    return {static_cast<int8_t>(c > 0 ? 1 : (c < 0 ? -1 : 0)), s,
+            c != 0 ? (static_cast<int64_t>(s) * 65536) / c : 0};
+  };
+  auto unitX = [](int32_t deg) { return static_cast<int32_t>(std::lround(std::cos(deg * 3.14159265f / 180.0f) * 16384.0f)); };
+  auto unitY = [](int32_t deg) { return static_cast<int32_t>(std::lround(std::sin(deg * 3.14159265f / 180.0f) * 16384.0f)); };
+
+  Piece pieces[2];
+  uint8_t pieceCount = 0;
+  int32_t pieceStart = startDeg;
+  int32_t remaining = sweep;
+  while (remaining > 0) {
+    const int32_t len = remaining > 180 ? 180 : remaining;
+    const int32_t pieceEnd = pieceStart + len;
+    // cross(start, p) >= 0  ->  startY * dx <= startX * dy
+    // cross(p, end) >= 0    ->  -endY * dx <= -endX * dy
+    pieces[pieceCount++] = {makeHalfPlane(unitY(pieceStart), unitX(pieceStart)),
+                            makeHalfPlane(-unitY(pieceEnd), -unitX(pieceEnd))};
+    pieceStart = pieceEnd;
+    remaining -= len;
+  }
+
+  auto clip = [](const HalfPlane &h, int16_t dy, int32_t &a, int32_t &b) -> bool {
+    if (h.sign == 0) {
+      return static_cast<int64_t>(h.s) * dy >= 0;
+    }
+    const int64_t bound = h.slope * dy;
+    if (h.sign > 0) {
+      b = static_cast<int32_t>(std::min<int64_t>(b, bound >> 16));
+    } else {
+      a = static_cast<int32_t>(std::max<int64_t>(a, (bound + 0xFFFF) >> 16));
+    }
+    return a <= b;
+  };
+  auto pieceInterval = [&clip](const Piece &p, int16_t dy, int16_t lo, int16_t hi, detail::Interval &out) -> bool {
+    int32_t a = lo;
+    int32_t b = hi;
+    if (!clip(p.start, dy, a, b) || !clip(p.end, dy, a, b)) return false;
+    out = {static_cast<int16_t>(a), static_cast<int16_t>(b)};
+    return true;
+  };
+
+  int16_t outerHalf = rOuter;
+  int16_t innerHalf = rInner;
+  for (int16_t dy = 0; dy <= rOuter; ++dy) {
+    outerHalf = circleHalfWidth(rOuter, dy, outerHalf);
+    innerHalf = (rInner >= 0 && dy <= rInner) ? circleHalfWidth(rInner, dy, innerHalf) : -1;
+    detail::Interval ringSpans[2];
+    const uint8_t ringCount = detail::ringIntervals(outerHalf, innerHalf, ringSpans);
+
+    for (int8_t sign = 1; sign >= -1; sign -= 2) {
+      if (dy == 0 && sign < 0) break;
+      const int16_t rowDy = static_cast<int16_t>(dy * sign);
+      for (uint8_t r = 0; r < ringCount; ++r) {
+        detail::Interval cover[2];
+        uint8_t coverCount = 0;
+        for (uint8_t i = 0; i < pieceCount; ++i) {
+          detail::Interval piece;
+          if (pieceInterval(pieces[i], rowDy, ringSpans[r].a, ringSpans[r].b, piece)) {
+            cover[coverCount++] = piece;
+          }
+        }
+        // Two pieces can meet on a shared boundary ray; merge so no pixel repeats.
+        if (coverCount == 2 && cover[1].a <= cover[0].b + 1 && cover[0].a <= cover[1].b + 1) {
+          cover[0] = {std::min(cover[0].a, cover[1].a), std::max(cover[0].b, cover[1].b)};
+          coverCount = 1;
+        }
+        for (uint8_t i = 0; i < coverCount; ++i) {
+          sink.hspan(cx + cover[i].a, cx + cover[i].b, cy + rowDy);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace raster
+}  // namespace graphics
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "font5x7.h"
+#include "graphics.h"
+#include "raster.h"
+
+namespace graphics {
+
+// Shape front end shared by the concrete backends. Every shape is broken
+// into runs here and the runs go to the backend's own fillArea(), which is
+// resolved at compile time: span loops inline into each backend, and a call
+// through a reference to a (final) backend skips the vtable altogether.
+// Graphics remains the virtual adapter for code that picks a backend at
+// run time.
+//
+// A backend derives from RasterGraphics<Itself> and provides, befriending
+// this class if they are private:
+//   Paint paintFor(uint16_t color);  // what fillArea takes, e.g. an index
+//   void fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Paint paint);
+// where the inclusive corners may come in either order. Any shape can still
+// be overridden where a backend does better.
+template <typename Derived>
+class RasterGraphics : public Graphics {
+ public:
+  void fillScreen(uint16_t color) override {
+    self().fillArea(0, 0, self().width() - 1, self().height() - 1, self().paintFor(color));
+  }
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    if (w <= 0 || h <= 0) return;
+    self().fillArea(x, y, x + w - 1, y + h - 1, self().paintFor(color));
+  }
+
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    if (w <= 0 || h <= 0) return;
+    const auto paint = self().paintFor(color);
+    self().fillArea(x, y, x + w - 1, y, paint);
+    self().fillArea(x, y + h - 1, x + w - 1, y + h - 1, paint);
+    if (h > 2) {
+      self().fillArea(x, y + 1, x, y + h - 2, paint);
+      self().fillArea(x + w - 1, y + 1, x + w - 1, y + h - 2, paint);
+    }
+  }
+
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override {
+    if (x0 == x1 || y0 == y1) {
+      self().fillArea(x0, y0, x1, y1, self().paintFor(color));
+      return;
+    }
+    raster::lineRuns(x0, y0, x1, y1, sinkFor(color));
+  }
+
+  void fillTriangle(int16_t x0, int16_t y0,
+                    int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2,
+                    uint16_t color) override {
+    const raster::SubPoint points[3] = {
+      raster::pixelCenter(x0, y0),
+      raster::pixelCenter(x1, y1),
+      raster::pixelCenter(x2, y2),
+    };
+    raster::convexPolygon(points, 3, sinkFor(color));
+  }
+
+  void fillPolygon(const Point *points, uint8_t count, uint16_t color) override {
+    if (!points || count > raster::kMaxPolygonVertices) return;
+    raster::SubPoint subPoints[raster::kMaxPolygonVertices];
+    for (uint8_t i = 0; i < count; ++i) {
+      subPoints[i] = raster::pixelCenter(points[i].x, points[i].y);
+    }
+    raster::convexPolygon(subPoints, count, sinkFor(color));
+  }
+
+  void drawWideLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, uint16_t color) override {
+    raster::wideLine(x0, y0, x1, y1, width, sinkFor(color));
+  }
+
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) override {
+    raster::disc(x0, y0, r, sinkFor(color));
+  }
+
+  void fillRing(int16_t x0, int16_t y0, int16_t rOuter, int16_t rInner, uint16_t color) override {
+    raster::ring(x0, y0, rOuter, rInner, sinkFor(color));
+  }
+
+  void fillArc(int16_t x0, int16_t y0, int16_t rOuter, int16_t rInner,
+               int16_t startDeg, int16_t endDeg, uint16_t color) override {
+    raster::arc(x0, y0, rOuter, rInner, startDeg, endDeg, sinkFor(color));
+  }
+
+  void fillSpans(const Span *spans, uint16_t count, uint16_t color) override {
+    if (!spans) return;
+    const auto paint = self().paintFor(color);
+    for (uint16_t i = 0; i < count; ++i) {
+      self().fillArea(spans[i].x0, spans[i].y, spans[i].x1, spans[i].y, paint);
+    }
+  }
+
+  void fillRects(const Rect *rects, uint16_t count, uint16_t color) override {
+    if (!rects) return;
+    const auto paint = self().paintFor(color);
+    for (uint16_t i = 0; i < count; ++i) {
+      const Rect &rect = rects[i];
+      if (rect.w <= 0 || rect.h <= 0) continue;
+      self().fillArea(rect.x, rect.y, rect.x + rect.w - 1, rect.y + rect.h - 1, paint);
+    }
+  }
+
+  void drawPolyline(const Point *points, uint8_t count, uint8_t width, uint16_t color) override {
+    raster::polyline(points, count, width, sinkFor(color));
+  }
+
+  void drawText(int16_t x, int16_t y,
+                const char *text,
+                uint16_t colorText, uint16_t colorBG,
+                uint8_t textSize) override {
+    if (!text) return;
+
+    const int scale = font5x7::scaleFor(textSize);
+    const int16_t lineHeight = static_cast<int16_t>(font5x7::kLineAdvance * scale);
+    while (true) {
+      const size_t length = std::strcspn(text, "\n");
+      if (length > 0) {
+        const int16_t lineWidth = static_cast<int16_t>(length * font5x7::kAdvance * scale);
+        self().drawTextBox(x, y, lineWidth, lineHeight, x, y, text, colorText, colorBG, textSize);
+      }
+      if (text[length] == '\0') break;
+      text += length + 1;
+      y += lineHeight;
+    }
+  }
+
+ protected:
+  // Adapts the raster:: walkers to fillArea() in one prepared paint.
+  template <typename Paint>
+  struct AreaSink {
+    Derived &gfx;
+    Paint paint;
+    void hspan(int16_t x0, int16_t x1, int16_t y) { gfx.fillArea(x0, y, x1, y, paint); }
+    void vspan(int16_t x, int16_t y0, int16_t y1) { gfx.fillArea(x, y0, x, y1, paint); }
+  };
+
+  Derived &self() { return static_cast<Derived &>(*this); }
+
+  auto sinkFor(uint16_t color) {
+    return AreaSink<decltype(self().paintFor(color))>{self(), self().paintFor(color)};
+  }
+};
+
+}  // namespace graphics
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "graphics.h"
+#include "graphics_utils.h"
+#include "raster_graphics.h"
+
+namespace graphics {
+
+// Records a frame's drawing as a display list of opaque rects, solid, holding
+// a line of text or filled by a RowSource, and replays it on endFrame(). Replay resolves the
+// list row by row, so pixels painted over later in the frame are never sent,
+// adjacent runs of one color merge and identical runs on consecutive rows
+// become a single rect.
+class RecordingGraphics final : public RasterGraphics<RecordingGraphics> {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  explicit RecordingGraphics(Graphics &target);
+  ~RecordingGraphics() override;
+
+  RecordingGraphics(const RecordingGraphics &) = delete;
+  RecordingGraphics &operator=(const RecordingGraphics &) = delete;
+
+  // Allocates room for `capacity` rects, 12 bytes each. Without it every
+  // command is passed straight through.
+  bool begin(size_t capacity = kDefaultCapacity);
+
+  // Replays and clears the list. A full list is replayed early, which keeps
+  // the output correct but coalesces less.
+  void endFrame();
+  size_t recordedCount() const { return count_; }
+
+  uint8_t getRotation() const override { return rotation_; }
+  void setRotation(uint8_t rotation) override { rotation_ = rotation % 4; }
+
+  // Applied while recording, upright like the fills, so the target never
+  // sees a clip and replay sends only what survived it.
+  void pushClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) override { clips_.push(x0, y0, x1, y1, rotation_); }
+  void popClip() override { clips_.pop(); }
+
+  void drawTextBox(int16_t x, int16_t y, int16_t w, int16_t h,
+                   int16_t textX, int16_t textY,
+                   const char *text,
+                   uint16_t colorText, uint16_t colorBG,
+                   uint8_t textSize) override;
+
+  // The source and its context must stay valid until the frame is replayed.
+  void drawRows(int16_t x, int16_t y, int16_t w, int16_t h, RowSource source, void *context) override;
+
+  // Replays the frame, then flushes the target.
+  void flush() override;
+
+  int16_t width() const override { return kSize; }
+  int16_t height() const override { return kSize; }
+
+  // Anything recorded reaches the panel before its power state changes.
+  void displayOn() override;
+  void displayOff() override;
+
+ private:
+  static constexpr int16_t kSize = 240;
+  static constexpr uint8_t kMaxTexts = 32;
+  static constexpr size_t kTextBytes = 512;
+  static constexpr uint8_t kMaxRowSources = 16;
+  static constexpr uint16_t kUncovered = UINT16_MAX;
+
+  // Inclusive rect in rotation-0 coordinates. `text` is 0 for a solid fill
+  // in `color`, else one more than the index of the text drawn over it, or
+  // kMaxTexts plus one more than the index of the rows it shows.
+  struct Fill {
+    uint8_t x0;
+    uint8_t y0;
+    uint8_t x1;
+    uint8_t y1;
+    uint16_t color;
+    uint8_t text;
+  };
+
+  // First line of a text box, replayed with drawTextBox at its rotation.
+  struct Text {
+    int16_t x;
+    int16_t y;
+    uint16_t color;
+    uint16_t offset;
+    uint8_t size;
+    uint8_t rotation;
+  };
+
+  // Rows drawn through a RowSource, replayed with drawRows at their rotation.
+  struct Rows {
+    RowSource source;
+    void *context;
+    uint8_t rotation;
+  };
+
+  // Run of one fill kind on the row being resolved; y0 is where it started.
+  struct Run {
+    uint8_t x0;
+    uint8_t x1;
+    uint8_t y0;
+    uint8_t text;
+    uint16_t color;
+  };
+
+  friend class RasterGraphics<RecordingGraphics>;
+
+  uint16_t paintFor(uint16_t color) const { return color; }
+  void fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) { record(x0, y0, x1, y1, color); }
+  void record(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint8_t text = 0);
+  void emit(const Run &run, int16_t y1);
+  void resolveRow(int16_t y, uint16_t activeCount);
+
+  Graphics &target_;
+  uint8_t rotation_;
+  ClipStack clips_{kSize};
+
+  Fill *fills_ = nullptr;
+  // Fill indices ordered by first row, then by recording order.
+  uint16_t *order_ = nullptr;
+  // Fills covering the current row, in recording order.
+  uint16_t *active_ = nullptr;
+  size_t capacity_ = 0;
+  size_t count_ = 0;
+
+  Text texts_[kMaxTexts];
+  char textChars_[kTextBytes];
+  uint8_t textCount_ = 0;
+  size_t textBytes_ = 0;
+
+  Rows rows_[kMaxRowSources];
+  uint8_t rowsCount_ = 0;
+
+  // Last fill covering each column of the row being resolved.
+  uint16_t owner_[kSize];
+  Run runs_[2][kSize];
+  uint16_t runCount_[2] = {0, 0};
+};
+
+}  // namespace graphics
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "gc9a01_graphics.h"
+
+namespace render_bench {
+
+// Logs per-call time and SPI cost of renderer primitives over Serial. The
+// framebuffer is bypassed while it runs so every case hits the panel,
+// except the frame cases, which time rasterizing into it.
+void run(graphics::Gc9a01Graphics &panel);
+
+}  // namespace render_bench
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#include "system_stats.h"
+
+namespace render_task {
+
+// One frame to draw, with a snapshot of everything it shows so the
+// renderer never reads state the main loop is updating.
+struct FrameRequest {
+  enum class Kind : uint8_t {
+    WatchfaceTick,  // repaint what changed since the last watchface frame
+    WatchfaceFull,  // repaint the whole watchface
+    Info,           // repaint the info screen
+  };
+  Kind kind = Kind::WatchfaceTick;
+  tm time{};
+  uint32_t steps = 0;
+  uint8_t batteryPercent = 0;
+  float batteryVoltage = 0.0f;
+  system_stats::Stats stats{};
+};
+
+// Starts the render task on the core the Arduino loop does not use. From
+// then on it owns the watchface and the display; false on single-core
+// builds or when the task cannot be created, and frames are then drawn by
+// service() from the loop.
+bool start();
+bool running();
+
+// Queues a frame without waiting for it to be drawn. Frames queued while
+// the renderer is busy are merged, so only the newest state is shown. Only
+// blocks if the queue is full, i.e. the render task is several frames
+// behind.
+void submit(const FrameRequest &request);
+
+// Without the render task, draws queued frames a step at a time (a widget,
+// a damaged rect) for up to HACKTOR_RENDER_BUDGET_US per call and resumes
+// on the next call; each frame is flushed once it is complete. Call it
+// once per loop() pass. Does nothing while the render task runs.
+void service();
+
+// Returns once every submitted frame is drawn and flushed, finishing them
+// here without the render task. Call it before touching the display from
+// the loop, e.g. to power the panel down.
+void waitIdle();
+
+}  // namespace render_task
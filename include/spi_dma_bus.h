@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "driver/spi_master.h"
+#include "graphics.h"
+
+namespace graphics {
+
+// Write-only link to a DC/CS style panel built on the ESP-IDF SPI master
+// queue. Every call only queues work; transfers complete in the background
+// and are reclaimed lazily when a descriptor or staging buffer is reused.
+// CS is driven by the SPI peripheral itself; DC is set per transaction from
+// the pre-transfer callback.
+class SpiDmaBus {
+ public:
+  static constexpr size_t kStagingBytes = 4096;
+  // One GPSPI transaction tops out at 2^18 bits; stay below it on row boundaries.
+  static constexpr size_t kMaxTransferBytes = 240 * 2 * 64;
+
+  SpiDmaBus() = default;
+  ~SpiDmaBus();
+
+  SpiDmaBus(const SpiDmaBus &) = delete;
+  SpiDmaBus &operator=(const SpiDmaBus &) = delete;
+
+  bool begin(spi_host_device_t host, int pin_sck, int pin_mosi, int pin_cs, int pin_dc, uint32_t freq_hz);
+  void end();
+  bool ready() const { return device_ != nullptr; }
+
+  void command(uint8_t cmd);
+  void data(const uint8_t *bytes, size_t len);
+  void setWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+
+  // Staging buffers are DMA capable and alternate: while one is on the wire
+  // the caller fills the other.
+  uint8_t *stagingBuffer();
+  void submitStaging(size_t len);
+
+  // Sends big-endian 16-bit `value` `count` times, reusing one staged pattern.
+  void fill16(uint16_t value, size_t count);
+  // Same for a 12-bit `value`, packed two pixels per three bytes. An odd
+  // count ends on a half-used byte, which the panel discards.
+  void fill12(uint16_t value, size_t count);
+
+  // Zero-copy send; `bytes` must be DMA capable and untouched until waitIdle().
+  void writeDma(const uint8_t *bytes, size_t len);
+
+  void waitIdle();
+  // Sequence number of the last queued transaction, for waitForSequence().
+  uint32_t queuedSequence() const { return queuedSeq_; }
+  void waitForSequence(uint32_t seq);
+
+  const TransferStats &stats() const { return stats_; }
+  void resetStats() { stats_ = {}; }
+
+ private:
+  static constexpr uint8_t kQueueDepth = 16;
+  static constexpr uint8_t kNoPattern = 0xFF;
+  // Solid patterns are staged at least one panel row wide so that
+  // consecutive short runs of one color can share them.
+  static constexpr size_t kMinPatternPixels = 240;
+
+  spi_transaction_t &nextDescriptor();
+  void queue(spi_transaction_t &t);
+  void queueBytes(const uint8_t *bytes, size_t len);
+  void queueInline(const uint8_t *bytes, size_t len, bool isData);
+  void fillPattern(uint16_t value, size_t count, uint8_t bitsPerPixel);
+  void reclaimOne();
+
+  spi_host_device_t host_ = SPI3_HOST;
+  spi_device_handle_t device_ = nullptr;
+  int dc_ = -1;
+  spi_transaction_t ring_[kQueueDepth] = {};
+  uint8_t head_ = 0;
+  uint8_t inFlight_ = 0;
+  uint32_t queuedSeq_ = 0;
+  uint32_t completedSeq_ = 0;
+  uint8_t *staging_[2] = {nullptr, nullptr};
+  uint32_t stagingSeq_[2] = {0, 0};
+  uint8_t activeStaging_ = 0;
+  uint8_t patternStaging_ = kNoPattern;
+  uint16_t patternValue_ = 0;
+  uint8_t patternBits_ = 0;
+  size_t patternPixels_ = 0;
+  TransferStats stats_;
+};
+
+}  // namespace graphics
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graphics.h"
+
+namespace graphics {
+
+// An RGB565 bitmap drawn over what is already on screen: pixels equal to
+// `key` are left out.
+struct Sprite {
+  const uint16_t *pixels = nullptr;  // width * height, row by row
+  uint16_t width = 0;
+  uint16_t height = 0;
+  uint16_t key = 0x0000;
+  // Point the sprite turns about, in sprite pixels.
+  int16_t pivotX = 0;
+  int16_t pivotY = 0;
+};
+
+// Angles below are tenths of a degree, clockwise on screen; at 0 the sprite
+// is drawn as stored.
+
+// Screen rect holding sprite columns u0..u1 of `sprite` turned by `angle`
+// with its pivot at (x, y); 0..width - 1 bounds the whole sprite.
+Rect rotatedSpriteBounds(const Sprite &sprite, int16_t x, int16_t y, int16_t angle, int16_t u0, int16_t u1);
+
+// Draws `sprite` turned by `angle` with its pivot at (x, y). Each screen
+// pixel in the turned bounds takes the sprite pixel under its center,
+// mapped back in 16.16 fixed point, and only the part of each row that
+// lands inside the sprite is walked. Runs of one color go out through
+// fillSpans.
+void drawRotatedSprite(Graphics &display, const Sprite &sprite, int16_t x, int16_t y, int16_t angle);
+
+// One sprite at `positions` evenly spaced angles, each rotated into spans
+// the first time it is drawn and replayed from then on, so a hand stepping
+// through 60 or 720 positions samples each of them once.
+class RotatedSpriteCache {
+ public:
+  RotatedSpriteCache() = default;
+  ~RotatedSpriteCache();
+
+  RotatedSpriteCache(const RotatedSpriteCache &) = delete;
+  RotatedSpriteCache &operator=(const RotatedSpriteCache &) = delete;
+
+  // Keeps up to `bytes` of spans in PSRAM. Positions that do not fit, or
+  // whose sprite reaches further than 127 px from the pivot, are rotated on
+  // every draw instead; false without the memory, which leaves every draw
+  // uncached.
+  bool begin(const Sprite &sprite, uint16_t positions, size_t bytes);
+
+  const Sprite &sprite() const { return sprite_; }
+  uint16_t positions() const { return positions_; }
+  int16_t angleOf(uint16_t position) const;
+  // Sprite columns holding every opaque pixel, for tighter bounds; the
+  // first is past the last when there are none.
+  int16_t firstOpaqueColumn() const { return firstOpaque_; }
+  int16_t lastOpaqueColumn() const { return lastOpaque_; }
+
+  void draw(Graphics &display, int16_t x, int16_t y, uint16_t position);
+
+ private:
+  bool build(uint16_t position);
+
+  Sprite sprite_;
+  uint16_t positions_ = 1;
+  int16_t firstOpaque_ = 0;
+  int16_t lastOpaque_ = -1;
+  // Per position: where its spans start in arena_, or one of the markers
+  // in sprite.cpp.
+  uint32_t *offsets_ = nullptr;
+  uint8_t *arena_ = nullptr;
+  size_t capacity_ = 0;
+  size_t used_ = 0;
+};
+
+}  // namespace graphics
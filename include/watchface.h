@@ -5,6 +5,12 @@
 
 #include "graphics.h"
 
+namespace graphics {
+class Gc9a01Graphics;
+class IndexedCanvas;
+class RecordingGraphics;
+}  // namespace graphics
+
 namespace watchface {
 
 constexpr int WIDTH  = 240;
@@ -13,6 +19,8 @@ constexpr int CENTER_X = 120;
 constexpr int CENTER_Y = 119;
 constexpr int RADIUS   = 120;
 constexpr float DEGREES_TO_RAD = 3.14159265f / 180.0f;
+constexpr uint8_t HAND_WIDTH = 3;
+constexpr uint8_t MAJOR_TICK_WIDTH = 4;
 
 constexpr uint16_t COLOR_BG        = 0x0000;
 constexpr uint16_t COLOR_FACE      = 0xFFFF;
@@ -22,23 +30,47 @@ constexpr uint16_t COLOR_SEC_HAND  = 0xF800;
 constexpr uint16_t COLOR_DATE_NUM  = 0xF800;
 constexpr uint16_t COLOR_STEPS     = 0xFFFF;
 
+// Builds the trig tables, loads hand images from the image pack and renders
+// the static dial into a cached layer.
 void init();
 
-void drawTicks(graphics::Graphics &display);
-void drawDateRotatedCWRightOfCenter(graphics::Graphics &display, const tm &currentTime);
-void drawStepsBelowCenter(graphics::Graphics &display, uint32_t stepsToday);
-void drawBatteryRotatedCWLeftOfCenter(graphics::Graphics &display, uint8_t batteryPercent);
-void drawThick3Line(graphics::Graphics &display, int x0, int y0, int x1, int y1, uint16_t color);
-void drawFullFaceAndHands(
-  graphics::Graphics &display,
-  const tm &currentTime,
-  uint32_t stepsToday,
-  uint8_t batteryPercent,
-  int &prev_hx, int &prev_hy,
-  int &prev_mx, int &prev_my,
-  int &prev_sx, int &prev_sy,
-  int &prev_stx, int &prev_sty
-);
+// The face is retained: update() stores what each element shows and marks
+// the areas whose content changed as damaged; nothing is drawn until one of
+// the draw calls below.
+void update(const tm &currentTime, uint32_t stepsToday, uint8_t batteryPercent);
+
+// The draw calls take the display as its own type. For a backend (they are
+// final) every primitive then binds at compile time and the span loops
+// inline into the face; through Graphics& each one goes through the
+// vtable. Both are instantiated in watchface.cpp for the types below.
+
+// Paints the whole face from the last update(). Safe to replay per band.
+template <typename Display>
+void drawFull(Display &display);
+// Repaints only the damaged areas, each clipped to itself.
+template <typename Display>
+void drawDamage(Display &display);
+
+// The same two paints split into steps, for callers that spread a frame
+// over several passes: the base and then each widget for a full paint, or
+// one damaged rect per step. drawStep() returns false once the frame is
+// complete; update() must not run while one is open.
+void beginFrame(bool full);
+template <typename Display>
+bool drawStep(Display &display);
+
+extern template void drawFull(graphics::Graphics &);
+extern template void drawDamage(graphics::Graphics &);
+extern template bool drawStep(graphics::Graphics &);
+extern template void drawFull(graphics::Gc9a01Graphics &);
+extern template void drawDamage(graphics::Gc9a01Graphics &);
+extern template bool drawStep(graphics::Gc9a01Graphics &);
+extern template void drawFull(graphics::RecordingGraphics &);
+extern template void drawDamage(graphics::RecordingGraphics &);
+extern template bool drawStep(graphics::RecordingGraphics &);
+extern template void drawFull(graphics::IndexedCanvas &);
+extern template void drawDamage(graphics::IndexedCanvas &);
+extern template bool drawStep(graphics::IndexedCanvas &);
 
 void calcHourEnd(const tm &currentTime, int &hx, int &hy);
 void calcMinuteEnd(const tm &currentTime, int &mx, int &my);
@@ -0,0 +1,80 @@
+#include "aa_text.h"
+
+#include <algorithm>
+
+#include "pixel_kernels.h"
+
+namespace graphics {
+namespace {
+
+constexpr uint8_t kFirstCode = 0x20;
+constexpr uint8_t kLastCode = 0x7E;
+
+const AaGlyph *glyphFor(const AaFont &font, char c) {
+  const uint8_t code = static_cast<uint8_t>(c);
+  if (code < kFirstCode || code > kLastCode) return nullptr;
+  const uint8_t index = font.index[code - kFirstCode];
+  return index == kNoGlyph ? nullptr : &font.glyphs[index];
+}
+
+inline bool endOfLine(char c) {
+  return c == '\0' || c == '\n';
+}
+
+}  // namespace
+
+void AaTextRun::setColors(uint16_t color, uint16_t background, uint8_t shades) {
+  shades = std::min<uint8_t>(std::max<uint8_t>(shades, 2), 16);
+  const int r0 = background >> 11, g0 = (background >> 5) & 0x3F, b0 = background & 0x1F;
+  const int r1 = color >> 11, g1 = (color >> 5) & 0x3F, b1 = color & 0x1F;
+  for (int level = 0; level < 16; ++level) {
+    // Rounded to one of `shades` evenly spaced steps between the two.
+    const int step = (level * (shades - 1) + 7) / 15;
+    const int r = r0 + ((r1 - r0) * step + (shades - 1) / 2) / (shades - 1);
+    const int g = g0 + ((g1 - g0) * step + (shades - 1) / 2) / (shades - 1);
+    const int b = b0 + ((b1 - b0) * step + (shades - 1) / 2) / (shades - 1);
+    ramp[level] = static_cast<uint16_t>((r << 11) | (g << 5) | b);
+  }
+}
+
+int16_t aaTextWidth(const AaFont &font, const char *text) {
+  if (!text) return 0;
+  int width = 0;
+  for (const char *c = text; !endOfLine(*c); ++c) {
+    const AaGlyph *glyph = glyphFor(font, *c);
+    if (glyph) width += glyph->advance;
+  }
+  return static_cast<int16_t>(width);
+}
+
+void readAaTextRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest) {
+  const AaTextRun &run = *static_cast<const AaTextRun *>(context);
+  pixels::fill(dest, run.ramp[0], x1 - x0 + 1);
+  const AaFont &font = *run.font;
+  const int line = y - run.y;
+  if (line < 0 || line >= font.height) return;
+
+  int pen = run.x;
+  for (const char *c = run.text; !endOfLine(*c) && pen <= x1; ++c) {
+    const AaGlyph *glyph = glyphFor(font, *c);
+    if (!glyph) continue;
+    const int row = line - glyph->top;
+    const int gx0 = pen + glyph->left;
+    pen += glyph->advance;
+    if (row < 0 || row >= glyph->height) continue;
+    const int a = std::max<int>(gx0, x0);
+    const int b = std::min<int>(gx0 + glyph->width - 1, x1);
+    if (a > b) continue;
+
+    const uint8_t *bits = font.bitmaps + glyph->offset + row * ((glyph->width + 1) / 2);
+    for (int px = a; px <= b; ++px) {
+      const int i = px - gx0;
+      const uint8_t level = (i & 1) ? bits[i / 2] >> 4 : bits[i / 2] & 0x0F;
+      // Where neighbours overlap, an edge does not eat into earlier ink.
+      uint16_t &out = dest[px - x0];
+      if (level == 15 || (level != 0 && out == run.ramp[0])) out = run.ramp[level];
+    }
+  }
+}
+
+}  // namespace graphics
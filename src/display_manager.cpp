@@ -2,13 +2,49 @@
 
 #include <Arduino.h>
 
+#include "debug_log.h"
 #include "hardware_pins.h"
 #include "gc9a01_graphics.h"
+#include "indexed_canvas.h"
+#include "recording_graphics.h"
+
+#ifndef HACKTOR_RENDER_MODE
+#define HACKTOR_RENDER_MODE 1
+#endif
+
+#ifndef HACKTOR_ROUND_CLIP
+#define HACKTOR_ROUND_CLIP 1
+#endif
+
+#ifndef HACKTOR_COLOR_DEPTH
+#define HACKTOR_COLOR_DEPTH 12
+#endif
+
+#ifndef HACKTOR_RECORD_FRAMES
+#define HACKTOR_RECORD_FRAMES 1
+#endif
+
+// The copy of the shown frame only fits in PSRAM, which the
+// esp32-s3-devkitm-1 board this builds for does not have; a board with
+// PSRAM can turn it on.
+#ifndef HACKTOR_FRAME_DIFF
+#define HACKTOR_FRAME_DIFF 0
+#endif
 
 namespace display_manager {
 namespace {
 
+constexpr int kRenderModeDirect = 0;
+constexpr int kRenderModeFramebuffer = 1;
+constexpr int kRenderModeBanded = 2;
+constexpr int kRenderModeIndexed4 = 3;
+constexpr int kRenderModeIndexed8 = 4;
+
 graphics::Gc9a01Graphics *driver = nullptr;
+// Present in the indexed render modes; drawing then goes here.
+graphics::IndexedCanvas *canvas = nullptr;
+// Present when direct drawing is recorded; it replays into the driver.
+graphics::RecordingGraphics *recorder = nullptr;
 
 void ensureCreated() {
   if (!driver) {
@@ -19,6 +55,36 @@ void ensureCreated() {
       kResetPin,
       true
     );
+    driver->setRoundClipEnabled(HACKTOR_ROUND_CLIP != 0);
+    // The watchface palette is exact in 12 bits, so nothing is lost.
+    driver->setPixelFormat(HACKTOR_COLOR_DEPTH == 12 ? graphics::PixelFormat::Rgb444
+                                                     : graphics::PixelFormat::Rgb565);
+    if (HACKTOR_RENDER_MODE == kRenderModeFramebuffer) {
+      // Allocate early, before BLE fragments the heap; falls back to direct drawing.
+      if (driver->setFramebufferEnabled(true) && HACKTOR_FRAME_DIFF) {
+        // Full repaints then only send what changed; the copy this keeps
+        // only fits in PSRAM.
+        if (!driver->setFrameDiffEnabled(true)) {
+          LOG_PRINT(1, "[display] frame diff off: no PSRAM for the shown frame");
+        }
+      }
+    } else if (HACKTOR_RENDER_MODE == kRenderModeBanded) {
+      // Two 240x24 strips instead of a full frame; falls back to direct drawing.
+      driver->setBandedRenderingEnabled(true);
+    } else if (HACKTOR_RENDER_MODE == kRenderModeIndexed4 || HACKTOR_RENDER_MODE == kRenderModeIndexed8) {
+      // 28.8 or 57.6 KB of palette indices; falls back to direct drawing.
+      canvas = new graphics::IndexedCanvas(*driver, HACKTOR_RENDER_MODE == kRenderModeIndexed4 ? 4 : 8);
+      if (!canvas->begin()) {
+        delete canvas;
+        canvas = nullptr;
+      }
+    }
+    if (HACKTOR_RECORD_FRAMES && !canvas && !driver->framebufferEnabled()) {
+      // Only drawing that goes straight to the panel gains from coalescing.
+      // Without its arena the recorder passes commands straight through.
+      recorder = new graphics::RecordingGraphics(*driver);
+      recorder->begin();
+    }
   }
 }
 
@@ -29,6 +95,13 @@ void init() {
 }
 
 graphics::Graphics &get() {
+  ensureCreated();
+  if (recorder) return *recorder;
+  if (canvas) return *canvas;
+  return *driver;
+}
+
+graphics::Gc9a01Graphics &panel() {
   ensureCreated();
   return *driver;
 }
@@ -36,11 +109,54 @@ graphics::Graphics &get() {
 void begin(uint32_t freq_hz) {
   ensureCreated();
   driver->begin(freq_hz);
+  if (canvas) {
+    // Panel RAM was lost with the reset; the canvas still holds the frame.
+    canvas->invalidate();
+  }
 }
 
 void reinitializeAfterWake() {
   begin();
 }
 
+graphics::TransferStats transferStats() {
+  ensureCreated();
+  return driver->transferStats();
+}
+
+void resetTransferStats() {
+  ensureCreated();
+  driver->resetTransferStats();
+}
+
+bool bandedRendering() {
+  ensureCreated();
+  return driver->bandedRenderingEnabled();
+}
+
+bool renderBanded(void (*scene)(graphics::Gc9a01Graphics &display, void *context), void *context) {
+  ensureCreated();
+  if (!driver->bandedRenderingEnabled()) return false;
+  // Bands already send each pixel once; replay anything recorded first
+  // so it lands underneath.
+  if (recorder) recorder->endFrame();
+  driver->renderBanded(scene, context);
+  return true;
+}
+
+namespace detail {
+
+graphics::RecordingGraphics *recorder() {
+  ensureCreated();
+  return display_manager::recorder;
+}
+
+graphics::IndexedCanvas *canvas() {
+  ensureCreated();
+  return display_manager::canvas;
+}
+
+}  // namespace detail
+
 }  // namespace display_manager
 
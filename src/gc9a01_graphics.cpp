@@ -3,111 +3,246 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 
+#include "esp_heap_caps.h"
+#include "font5x7.h"
+#include "graphics_utils.h"
 #include "hardware_pins.h"
+#include "pixel_kernels.h"
+#include "raster.h"
 
 namespace {
 
 constexpr uint16_t kScreenSize = 240;
+constexpr size_t kFramebufferPixels = static_cast<size_t>(kScreenSize) * kScreenSize;
+// Merging two dirty rects is worth it when the union wastes fewer pixels than
+// roughly the cost of an extra address window.
+constexpr int32_t kDirtyMergeSlackPixels = 64;
+
+// Changed pixels on one row at most this far apart go out as one run; a
+// second address window costs about as much as resending the gap.
+constexpr int16_t kDiffGapPixels = 32;
+constexpr uint8_t kMaxDiffRuns = 8;
+
+// Changed runs of consecutive rows stack into one window while it resends
+// no more than this many unchanged pixels.
+constexpr int32_t kDiffStackSlackPixels = 64;
+
+// Inclusive run of changed pixels on one row.
+struct DiffRun {
+  int16_t x0;
+  int16_t x1;
+};
+
+// Window being grown downwards from row y0; `used` counts changed pixels.
+struct DiffWindow {
+  int16_t x0;
+  int16_t x1;
+  int16_t y0;
+  int32_t used;
+};
+
+// Finds where row[x0..x1] differs from previous[x0..x1], two pixels per
+// compare. Rows must start on a 4-byte boundary.
+uint8_t findChangedRuns(const uint16_t *row, const uint16_t *previous, int16_t x0, int16_t x1, DiffRun *runs) {
+  uint8_t count = 0;
+  for (int16_t w = x0 & ~1; w <= x1; w += 2) {
+    uint32_t now, before;
+    std::memcpy(&now, row + w, sizeof(now));
+    std::memcpy(&before, previous + w, sizeof(before));
+    if (now == before) continue;
+    const int16_t start = std::max<int16_t>(row[w] == previous[w] ? w + 1 : w, x0);
+    const int16_t end = std::min<int16_t>(row[w + 1] == previous[w + 1] ? w : w + 1, x1);
+    if (start > end) continue;
+    if (count > 0 && (start - runs[count - 1].x1 - 1 <= kDiffGapPixels || count == kMaxDiffRuns)) {
+      runs[count - 1].x1 = end;
+    } else {
+      runs[count++] = DiffRun{start, end};
+    }
+  }
+  return count;
+}
+
+// Rows of a clipped rect share one window while the bounding box of the
+// band sends no more than this many pixels the glass cannot show.
+constexpr int32_t kClipBandSlackPixels = 64;
+
+// Visible chord of every panel row on the round glass: the pixels whose
+// centers fall inside the inscribed circle. Symmetric, never empty.
+struct VisibleRows {
+  uint8_t min[kScreenSize];
+  uint8_t max[kScreenSize];
+};
+
+constexpr VisibleRows makeVisibleRows() {
+  VisibleRows rows{};
+  constexpr int32_t kDiameter = kScreenSize;
+  for (int32_t y = 0; y < kDiameter; ++y) {
+    const int32_t dy = 2 * y + 1 - kDiameter;
+    int32_t x = 0;
+    while ((2 * x + 1 - kDiameter) * (2 * x + 1 - kDiameter) + dy * dy > kDiameter * kDiameter) {
+      ++x;
+    }
+    rows.min[y] = static_cast<uint8_t>(x);
+    rows.max[y] = static_cast<uint8_t>(kDiameter - 1 - x);
+  }
+  return rows;
+}
+
+constexpr VisibleRows kVisibleRows = makeVisibleRows();
+
+// Cuts a panel rect down to the visible chords and hands out bands of rows
+// that can share one address window.
+template <typename Fn>
+void forEachVisibleBand(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Fn &&emit) {
+  auto chord = [&](int16_t y, int16_t &a, int16_t &b) {
+    a = std::max<int16_t>(x0, kVisibleRows.min[y]);
+    b = std::min<int16_t>(x1, kVisibleRows.max[y]);
+    return a <= b;
+  };
+  int16_t y = y0;
+  while (y <= y1) {
+    int16_t a, b;
+    if (!chord(y, a, b)) {
+      ++y;
+      continue;
+    }
+    int32_t used = b - a + 1;
+    int16_t end = y;
+    int16_t na, nb;
+    while (end < y1 && chord(end + 1, na, nb)) {
+      const int16_t ua = std::min(a, na);
+      const int16_t ub = std::max(b, nb);
+      const int32_t nextUsed = used + (nb - na + 1);
+      if (static_cast<int32_t>(ub - ua + 1) * (end + 2 - y) - nextUsed > kClipBandSlackPixels) break;
+      a = ua;
+      b = ub;
+      used = nextUsed;
+      ++end;
+    }
+    emit(a, y, b, end);
+    y = end + 1;
+  }
+}
+
+// Height of one band when a frame is rendered in horizontal strips.
+constexpr int16_t kBandRows = 24;
+constexpr size_t kBandPixels = static_cast<size_t>(kScreenSize) * kBandRows;
+
+// The framebuffer holds pixels in wire order so rows can be streamed as-is.
+inline uint16_t toPanelOrder(uint16_t color) {
+  return static_cast<uint16_t>((color >> 8) | (color << 8));
+}
+
+// RGB565 to the panel's 12-bit R4G4B4 by dropping the low bits per channel.
+inline uint16_t toRgb444(uint16_t color) {
+  return static_cast<uint16_t>(((color >> 4) & 0x0F00) | ((color >> 3) & 0x00F0) | ((color >> 1) & 0x000F));
+}
+
+// Streams wire-order RGB565 pixels out as RGB444, two pixels per three
+// bytes. Writing never overtakes reading, so it may pack in place.
+class Rgb444Packer {
+ public:
+  explicit Rgb444Packer(uint8_t *dest) : dest_(dest) {}
+
+  void push(uint16_t wire) {
+    const uint16_t pixel = toRgb444(toPanelOrder(wire));
+    if (!pending_) {
+      held_ = pixel;
+      pending_ = true;
+      return;
+    }
+    dest_[bytes_] = static_cast<uint8_t>(held_ >> 4);
+    dest_[bytes_ + 1] = static_cast<uint8_t>(((held_ & 0x0F) << 4) | (pixel >> 8));
+    dest_[bytes_ + 2] = static_cast<uint8_t>(pixel & 0xFF);
+    bytes_ += 3;
+    pending_ = false;
+  }
+
+  // Whole pairs go through the packing kernel; only a pixel left over from
+  // the last call or for the next one takes the slow path.
+  void push(const uint16_t *wire, size_t count) {
+    if (count > 0 && pending_) {
+      push(*wire++);
+      --count;
+    }
+    bytes_ += graphics::pixels::packRgb444(dest_ + bytes_, wire, count / 2);
+    if (count & 1) {
+      push(wire[count - 1]);
+    }
+  }
+
+  // Bytes written so far; a trailing odd pixel goes out in two bytes.
+  size_t finish() {
+    if (pending_) {
+      dest_[bytes_] = static_cast<uint8_t>(held_ >> 4);
+      dest_[bytes_ + 1] = static_cast<uint8_t>((held_ & 0x0F) << 4);
+      bytes_ += 2;
+      pending_ = false;
+    }
+    return bytes_;
+  }
+
+ private:
+  uint8_t *dest_;
+  size_t bytes_ = 0;
+  uint16_t held_ = 0;
+  bool pending_ = false;
+};
+
+// One line of text placed inside a box, colors already in wire order.
+struct TextRun {
+  int16_t x;
+  int16_t y;
+  const char *text;
+  size_t length;
+  uint16_t fg;
+  uint16_t bg;
+  int scale;
+};
+
+// Renders columns x0..x1 of logical row `y` of a text box into `dest`,
+// advancing `stride` pixels per column so rotated targets work unchanged.
+void renderTextRow(uint16_t *dest, ptrdiff_t stride, int16_t x0, int16_t x1, int16_t y, const TextRun &run) {
+  if (stride == 1) {
+    graphics::pixels::fill(dest, run.bg, x1 - x0 + 1);
+    graphics::font5x7::inkRuns(run.text, run.length, run.x, run.y, run.scale, x0, x1, y, [&](int a, int b) {
+      graphics::pixels::fill(dest + (a - x0), run.fg, b - a + 1);
+    });
+    return;
+  }
+  for (int px = x0; px <= x1; ++px) {
+    dest[(px - x0) * stride] = run.bg;
+  }
+  graphics::font5x7::inkRuns(run.text, run.length, run.x, run.y, run.scale, x0, x1, y, [&](int a, int b) {
+    for (int px = a; px <= b; ++px) {
+      dest[(px - x0) * stride] = run.fg;
+    }
+  });
+}
+
+// Writes RGB565 `row` in wire order to `dest`, `stride` pixels apart.
+void storeWireRow(uint16_t *dest, ptrdiff_t stride, const uint16_t *row, int16_t count) {
+  if (stride == 1) {
+    graphics::pixels::swapBytes(dest, row, count);
+    return;
+  }
+  for (int16_t i = 0; i < count; ++i) {
+    dest[i * stride] = toPanelOrder(row[i]);
+  }
+}
 
-// 5x7 font (ASCII 0x20..0x7F). Derived from public domain font data.
-constexpr uint8_t kFont5x7[96][5] = {
-  {0x00,0x00,0x00,0x00,0x00}, // ' '
-  {0x00,0x00,0x5f,0x00,0x00}, // '!'
-  {0x00,0x03,0x00,0x03,0x00}, // '"'
-  {0x14,0x7f,0x14,0x7f,0x14}, // '#'
-  {0x24,0x2a,0x7f,0x2a,0x12}, // '$'
-  {0x23,0x13,0x08,0x64,0x62}, // '%'
-  {0x36,0x49,0x55,0x22,0x50}, // '&'
-  {0x00,0x05,0x03,0x00,0x00}, // '\''
-  {0x00,0x1c,0x22,0x41,0x00}, // '('
-  {0x00,0x41,0x22,0x1c,0x00}, // ')'
-  {0x14,0x08,0x3e,0x08,0x14}, // '*'
-  {0x08,0x08,0x3e,0x08,0x08}, // '+'
-  {0x00,0x50,0x30,0x00,0x00}, // ','
-  {0x08,0x08,0x08,0x08,0x08}, // '-'
-  {0x00,0x60,0x60,0x00,0x00}, // '.'
-  {0x20,0x10,0x08,0x04,0x02}, // '/' 
-  {0x3e,0x51,0x49,0x45,0x3e}, // '0'
-  {0x00,0x42,0x7f,0x40,0x00}, // '1'
-  {0x42,0x61,0x51,0x49,0x46}, // '2'
-  {0x21,0x41,0x45,0x4b,0x31}, // '3'
-  {0x18,0x14,0x12,0x7f,0x10}, // '4'
-  {0x27,0x45,0x45,0x45,0x39}, // '5'
-  {0x3c,0x4a,0x49,0x49,0x30}, // '6'
-  {0x01,0x71,0x09,0x05,0x03}, // '7'
-  {0x36,0x49,0x49,0x49,0x36}, // '8'
-  {0x06,0x49,0x49,0x29,0x1e}, // '9'
-  {0x00,0x36,0x36,0x00,0x00}, // ':'
-  {0x00,0x56,0x36,0x00,0x00}, // ';'
-  {0x08,0x14,0x22,0x41,0x00}, // '<'
-  {0x14,0x14,0x14,0x14,0x14}, // '='
-  {0x00,0x41,0x22,0x14,0x08}, // '>'
-  {0x02,0x01,0x51,0x09,0x06}, // '?'
-  {0x3e,0x41,0x5d,0x59,0x4e}, // '@'
-  {0x7e,0x11,0x11,0x11,0x7e}, // 'A'
-  {0x7f,0x49,0x49,0x49,0x36}, // 'B'
-  {0x3e,0x41,0x41,0x41,0x22}, // 'C'
-  {0x7f,0x41,0x41,0x22,0x1c}, // 'D'
-  {0x7f,0x49,0x49,0x49,0x41}, // 'E'
-  {0x7f,0x09,0x09,0x09,0x01}, // 'F'
-  {0x3e,0x41,0x49,0x49,0x7a}, // 'G'
-  {0x7f,0x08,0x08,0x08,0x7f}, // 'H'
-  {0x00,0x41,0x7f,0x41,0x00}, // 'I'
-  {0x20,0x40,0x41,0x3f,0x01}, // 'J'
-  {0x7f,0x08,0x14,0x22,0x41}, // 'K'
-  {0x7f,0x40,0x40,0x40,0x40}, // 'L'
-  {0x7f,0x02,0x0c,0x02,0x7f}, // 'M'
-  {0x7f,0x04,0x08,0x10,0x7f}, // 'N'
-  {0x3e,0x41,0x41,0x41,0x3e}, // 'O'
-  {0x7f,0x09,0x09,0x09,0x06}, // 'P'
-  {0x3e,0x41,0x51,0x21,0x5e}, // 'Q'
-  {0x7f,0x09,0x19,0x29,0x46}, // 'R'
-  {0x26,0x49,0x49,0x49,0x32}, // 'S'
-  {0x01,0x01,0x7f,0x01,0x01}, // 'T'
-  {0x3f,0x40,0x40,0x40,0x3f}, // 'U'
-  {0x1f,0x20,0x40,0x20,0x1f}, // 'V'
-  {0x7f,0x20,0x18,0x20,0x7f}, // 'W'
-  {0x63,0x14,0x08,0x14,0x63}, // 'X'
-  {0x07,0x08,0x70,0x08,0x07}, // 'Y'
-  {0x61,0x51,0x49,0x45,0x43}, // 'Z'
-  {0x00,0x7f,0x41,0x41,0x00}, // '['
-  {0x02,0x04,0x08,0x10,0x20}, // '\\'
-  {0x00,0x41,0x41,0x7f,0x00}, // ']'
-  {0x04,0x02,0x01,0x02,0x04}, // '^'
-  {0x80,0x80,0x80,0x80,0x80}, // '_'
-  {0x00,0x01,0x02,0x04,0x00}, // '`'
-  {0x20,0x54,0x54,0x54,0x78}, // 'a'
-  {0x7f,0x48,0x44,0x44,0x38}, // 'b'
-  {0x38,0x44,0x44,0x44,0x20}, // 'c'
-  {0x38,0x44,0x44,0x48,0x7f}, // 'd'
-  {0x38,0x54,0x54,0x54,0x18}, // 'e'
-  {0x08,0x7e,0x09,0x01,0x02}, // 'f'
-  {0x0c,0x52,0x52,0x52,0x3e}, // 'g'
-  {0x7f,0x08,0x04,0x04,0x78}, // 'h'
-  {0x00,0x44,0x7d,0x40,0x00}, // 'i'
-  {0x20,0x40,0x44,0x3d,0x00}, // 'j'
-  {0x7f,0x10,0x28,0x44,0x00}, // 'k'
-  {0x00,0x41,0x7f,0x40,0x00}, // 'l'
-  {0x7c,0x04,0x18,0x04,0x78}, // 'm'
-  {0x7c,0x08,0x04,0x04,0x78}, // 'n'
-  {0x38,0x44,0x44,0x44,0x38}, // 'o'
-  {0x7c,0x14,0x14,0x14,0x08}, // 'p'
-  {0x08,0x14,0x14,0x18,0x7c}, // 'q'
-  {0x7c,0x08,0x04,0x04,0x08}, // 'r'
-  {0x48,0x54,0x54,0x54,0x20}, // 's'
-  {0x04,0x3f,0x44,0x40,0x20}, // 't'
-  {0x3c,0x40,0x40,0x20,0x7c}, // 'u'
-  {0x1c,0x20,0x40,0x20,0x1c}, // 'v'
-  {0x3c,0x40,0x30,0x40,0x3c}, // 'w'
-  {0x44,0x28,0x10,0x28,0x44}, // 'x'
-  {0x0c,0x50,0x50,0x50,0x3c}, // 'y'
-  {0x44,0x64,0x54,0x4c,0x44}, // 'z'
-  {0x00,0x08,0x36,0x41,0x00}, // '{'
-  {0x00,0x00,0x7f,0x00,0x00}, // '|'
-  {0x00,0x41,0x36,0x08,0x00}, // '}'
-  {0x10,0x08,0x08,0x10,0x08}, // '~'
-  {0x00,0x00,0x00,0x00,0x00}, // DEL -> unused
+// Adapts a RowSource of RGB565 colors to pushRows(), which wants wire order.
+struct WireRowSource {
+  graphics::RowSource source;
+  void *context;
+
+  static void read(void *self, int16_t y, int16_t x0, int16_t x1, uint16_t *dest) {
+    const WireRowSource &adapter = *static_cast<const WireRowSource *>(self);
+    adapter.source(adapter.context, y, x0, x1, dest);
+    graphics::pixels::swapBytes(dest, dest, x1 - x0 + 1);
+  }
 };
 
 constexpr uint8_t MADCTL_MY = 0x80;
@@ -115,6 +250,10 @@ constexpr uint8_t MADCTL_MX = 0x40;
 constexpr uint8_t MADCTL_MV = 0x20;
 constexpr uint8_t MADCTL_BGR = 0x08;
 
+// The scan direction is fixed at init; other rotations are applied in
+// software relative to Gc9a01Graphics::kPanelRotation.
+constexpr uint8_t kPanelMadctl = MADCTL_MX | MADCTL_MV | MADCTL_BGR;
+
 struct PanelCommand {
   uint8_t cmd;
   const uint8_t *data;
@@ -216,38 +355,162 @@ Gc9a01Graphics::Gc9a01Graphics(uint8_t pin_dc,
                                uint8_t pin_cs,
                                uint8_t pin_rst,
                                bool ips)
-    : spi_(HSPI),
-      dc_(pin_dc),
+    : dc_(pin_dc),
       cs_(pin_cs),
       rst_(pin_rst),
       ips_(ips) {}
 
-bool Gc9a01Graphics::begin(uint32_t freq_hz) {
-  pinMode(dc_, OUTPUT);
-  pinMode(cs_, OUTPUT);
-  digitalWrite(dc_, HIGH);
-  digitalWrite(cs_, HIGH);
+Gc9a01Graphics::~Gc9a01Graphics() {
+  bus_.waitIdle();
+  if (framebuffer_) {
+    heap_caps_free(framebuffer_);
+  }
+  heap_caps_free(shown_);
+  for (auto *band : bands_) {
+    heap_caps_free(band);
+  }
+}
 
+bool Gc9a01Graphics::begin(uint32_t freq_hz) {
   if (rst_ != 0xFF) {
     pinMode(rst_, OUTPUT);
     digitalWrite(rst_, HIGH);
   }
 
-  spi_.end();
-  spi_.begin(pins::LCD_SCK, -1, pins::LCD_MOSI, cs_);
+  // Re-running begin() after light sleep also re-routes the tri-stated pins.
+  if (!bus_.begin(SPI3_HOST, pins::LCD_SCK, pins::LCD_MOSI, cs_, dc_, freq_hz)) {
+    initialized_ = false;
+    return false;
+  }
   delay(20);
-  spi_settings_ = SPISettings(freq_hz, MSBFIRST, SPI_MODE0);
 
   hardwareReset();
   initPanel();
 
+  if (framebuffer_) {
+    // Panel RAM does not survive a reset; resend everything on the next flush.
+    markDirty(0, 0, kScreenSize - 1, kScreenSize - 1);
+    shownValid_ = false;
+  }
+
   initialized_ = true;
   return true;
 }
 
+bool Gc9a01Graphics::setFramebufferEnabled(bool enabled) {
+  if (enabled == (framebuffer_ != nullptr)) {
+    return true;
+  }
+  if (!enabled) {
+    flush();
+    awaitFramebuffer();
+    setFrameDiffEnabled(false);
+    heap_caps_free(framebuffer_);
+    framebuffer_ = nullptr;
+    target_ = nullptr;
+    dirtyCount_ = 0;
+    return true;
+  }
+  framebuffer_ = static_cast<uint16_t *>(
+    heap_caps_malloc(kFramebufferPixels * sizeof(uint16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA));
+  if (!framebuffer_) {
+    return false;
+  }
+  pixels::fill(framebuffer_, 0, kFramebufferPixels);
+  target_ = framebuffer_;
+  dirtyCount_ = 0;
+  return true;
+}
+
+bool Gc9a01Graphics::setFrameDiffEnabled(bool enabled) {
+  if (enabled == (shown_ != nullptr)) {
+    return true;
+  }
+  if (!enabled) {
+    heap_caps_free(shown_);
+    shown_ = nullptr;
+    shownValid_ = false;
+    return true;
+  }
+  if (!framebuffer_) {
+    return false;
+  }
+  // Only the CPU touches the copy, so slower external RAM is good enough.
+  // A second 115 KB in internal RAM next to the framebuffer would leave
+  // too little for BLE, so without PSRAM there is no diffing.
+  const size_t bytes = kFramebufferPixels * sizeof(uint16_t);
+  shown_ = static_cast<uint16_t *>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!shown_) {
+    return false;
+  }
+  // What the panel shows is unknown until one full frame has gone out.
+  shownValid_ = false;
+  markDirty(0, 0, kScreenSize - 1, kScreenSize - 1);
+  return true;
+}
+
+bool Gc9a01Graphics::setBandedRenderingEnabled(bool enabled) {
+  if (enabled == (bands_[0] != nullptr)) {
+    return true;
+  }
+  if (!enabled) {
+    bus_.waitIdle();
+    for (auto &band : bands_) {
+      heap_caps_free(band);
+      band = nullptr;
+    }
+    return true;
+  }
+  for (auto &band : bands_) {
+    band = static_cast<uint16_t *>(
+      heap_caps_malloc(kBandPixels * sizeof(uint16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA));
+    if (!band) {
+      setBandedRenderingEnabled(false);
+      return false;
+    }
+  }
+  bandSeq_[0] = bandSeq_[1] = bus_.queuedSequence();
+  return true;
+}
+
+void Gc9a01Graphics::renderBanded(SceneFn scene, void *context) {
+  if (!scene) return;
+  if (framebuffer_ || !bands_[0]) {
+    scene(*this, context);
+    return;
+  }
+
+  // Band n renders into one buffer while band n - 1 is still on the wire
+  // from the other. The scene paints every pixel, so bands are not cleared.
+  uint8_t active = 0;
+  for (int16_t top = 0; top < kScreenSize; top += kBandRows, active ^= 1) {
+    bus_.waitForSequence(bandSeq_[active]);
+    target_ = bands_[active];
+    targetTop_ = top;
+    targetBottom_ = std::min<int16_t>(top + kBandRows - 1, kScreenSize - 1);
+
+    scene(*this, context);
+
+    if (roundClip_) {
+      forEachVisibleBand(0, targetTop_, kScreenSize - 1, targetBottom_,
+                         [&](int16_t a, int16_t bandTop, int16_t b, int16_t bandBottom) {
+        sendFramebufferRect(a, bandTop, b, bandBottom);
+      });
+    } else {
+      sendFramebufferRect(0, targetTop_, kScreenSize - 1, targetBottom_);
+    }
+    bandSeq_[active] = bus_.queuedSequence();
+    framebufferInFlight_ = false;
+  }
+  target_ = nullptr;
+  targetTop_ = 0;
+  targetBottom_ = kScreenSize - 1;
+}
+
 void Gc9a01Graphics::hardwareReset() {
   if (rst_ == 0xFF) {
     writeCommand(0x01);  // Software reset
+    bus_.waitIdle();
     delay(120);
     return;
   }
@@ -267,393 +530,571 @@ void Gc9a01Graphics::initPanel() {
       writeCommand(item.cmd);
     }
     if (item.delay_ms) {
+      bus_.waitIdle();
       delay(item.delay_ms);
     }
   }
-  setRotation(1);
-}
-
-void Gc9a01Graphics::fillScreen(uint16_t color) {
-  fillRect(0, 0, width_, height_, color);
+  writeCommandWithData(0x36, &kPanelMadctl, 1);
+  setRotation(kPanelRotation);
+  setPixelFormat(pixelFormat_);
 }
 
-void Gc9a01Graphics::startWrite() {
-  spi_.beginTransaction(spi_settings_);
-  digitalWrite(cs_, LOW);
-}
-
-void Gc9a01Graphics::endWrite() {
-  digitalWrite(cs_, HIGH);
-  spi_.endTransaction();
+void Gc9a01Graphics::setPixelFormat(PixelFormat format) {
+  pixelFormat_ = format;
+  if (!bus_.ready()) return;
+  // Queued pixels still go out before the command, in the format they
+  // were packed for.
+  const uint8_t colmod = format == PixelFormat::Rgb444 ? 0x03 : 0x05;
+  writeCommandWithData(0x3A, &colmod, 1);
 }
 
 void Gc9a01Graphics::writeCommand(uint8_t cmd) {
-  startWrite();
-  digitalWrite(dc_, LOW);
-  spi_.write(cmd);
-  digitalWrite(dc_, HIGH);
-  endWrite();
+  bus_.command(cmd);
 }
 
 void Gc9a01Graphics::writeCommandWithData(uint8_t cmd, const uint8_t *data, size_t len) {
-  startWrite();
-  digitalWrite(dc_, LOW);
-  spi_.write(cmd);
-  digitalWrite(dc_, HIGH);
+  bus_.command(cmd);
   if (data && len) {
-    spi_.writeBytes(data, len);
+    bus_.data(data, len);
+  }
+}
+
+void Gc9a01Graphics::writeData16Repeat(uint16_t value, size_t count) {
+  if (pixelFormat_ == PixelFormat::Rgb444) {
+    bus_.fill12(toRgb444(value), count);
+    return;
   }
-  endWrite();
+  bus_.fill16(value, count);
 }
 
-void Gc9a01Graphics::writeData(const uint8_t *data, size_t len) {
-  spi_.writeBytes(data, len);
+void Gc9a01Graphics::setAddrWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  bus_.setWindow(x0, y0, x1, y1);
 }
 
-void Gc9a01Graphics::writeData16(uint16_t value) {
-  uint8_t buffer[2] = {static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFF)};
-  writeData(buffer, 2);
+void Gc9a01Graphics::waitForTransfers() {
+  bus_.waitIdle();
+  framebufferInFlight_ = false;
 }
 
-void Gc9a01Graphics::writeData16Repeat(uint16_t value, size_t count) {
-  uint8_t hi = static_cast<uint8_t>(value >> 8);
-  uint8_t lo = static_cast<uint8_t>(value & 0xFF);
-  uint8_t chunk[64];
-  for (size_t i = 0; i < sizeof(chunk); i += 2) {
-    chunk[i] = hi;
-    chunk[i + 1] = lo;
-  }
-  while (count > 0) {
-    size_t batch = std::min(count, sizeof(chunk) / 2);
-    spi_.writeBytes(chunk, batch * 2);
-    count -= batch;
+void Gc9a01Graphics::awaitFramebuffer() {
+  if (framebufferInFlight_) {
+    bus_.waitIdle();
+    framebufferInFlight_ = false;
   }
 }
 
-void Gc9a01Graphics::setAddrWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
-  digitalWrite(dc_, LOW);
-  spi_.write(0x2A);
-  digitalWrite(dc_, HIGH);
-  writeData16(x0);
-  writeData16(x1);
-
-  digitalWrite(dc_, LOW);
-  spi_.write(0x2B);
-  digitalWrite(dc_, HIGH);
-  writeData16(y0);
-  writeData16(y1);
-
-  digitalWrite(dc_, LOW);
-  spi_.write(0x2C);
-  digitalWrite(dc_, HIGH);
-}
-
-void Gc9a01Graphics::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-  if (w <= 0 || h <= 0) return;
-  if (x >= width_ || y >= height_) return;
-  int16_t x1 = std::min<int16_t>(x + w - 1, width_ - 1);
-  int16_t y1 = std::min<int16_t>(y + h - 1, height_ - 1);
-  if (x1 < 0 || y1 < 0) return;
-  if (x < 0) x = 0;
-  if (y < 0) y = 0;
-
-  const int16_t spanWidth = x1 - x + 1;
-  const int16_t spanHeight = y1 - y + 1;
-
-  startWrite();
-  setAddrWindow(x, y, x1, y1);
-
-  static uint8_t lineBuf[240 * 2];
-  const uint8_t hi = static_cast<uint8_t>(color >> 8);
-  const uint8_t lo = static_cast<uint8_t>(color & 0xFF);
-  const int bytesPerLine = spanWidth * 2;
-  if (bytesPerLine > static_cast<int>(sizeof(lineBuf))) {
-    endWrite();
-    return;
+void Gc9a01Graphics::fillLogicalRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  if (x0 > x1) std::swap(x0, x1);
+  if (y0 > y1) std::swap(y0, y1);
+  if (x1 < 0 || y1 < 0 || x0 >= width_ || y0 >= height_) return;
+  x0 = std::max<int16_t>(x0, 0);
+  y0 = std::max<int16_t>(y0, 0);
+  x1 = std::min<int16_t>(x1, width_ - 1);
+  y1 = std::min<int16_t>(y1, height_ - 1);
+  // Quarter turns keep rects axis-aligned, so a rotated span is still one
+  // window: a row becomes a column and vice versa.
+  rotateRect(x0, y0, x1, y1, panelTurns_, kScreenSize);
+  if (!clips_.clip(x0, y0, x1, y1)) return;
+  fillPanelRect(x0, y0, x1, y1, color);
+}
+
+void Gc9a01Graphics::fillPanelRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  if (target_) {
+    y0 = std::max(y0, targetTop_);
+    y1 = std::min(y1, targetBottom_);
+    if (y0 > y1) return;
   }
-  for (int16_t i = 0; i < spanWidth; ++i) {
-    lineBuf[i * 2]     = hi;
-    lineBuf[i * 2 + 1] = lo;
+  const int16_t spanWidth = x1 - x0 + 1;
+  const int16_t spanHeight = y1 - y0 + 1;
+
+  if (target_) {
+    awaitFramebuffer();
+    const uint16_t value = toPanelOrder(color);
+    if (roundClip_) {
+      // Corners are never flushed, so there is no point writing them.
+      bool visible = false;
+      for (int16_t y = y0; y <= y1; ++y) {
+        const int16_t a = std::max<int16_t>(x0, kVisibleRows.min[y]);
+        const int16_t b = std::min<int16_t>(x1, kVisibleRows.max[y]);
+        if (a > b) continue;
+        pixels::fill(target_ + (y - targetTop_) * kScreenSize + a, value, b - a + 1);
+        visible = true;
+      }
+      if (visible) {
+        markDirty(x0, y0, x1, y1);
+      }
+      return;
+    }
+    uint16_t *row = target_ + (y0 - targetTop_) * kScreenSize + x0;
+    for (int16_t i = 0; i < spanHeight; ++i, row += kScreenSize) {
+      pixels::fill(row, value, spanWidth);
+    }
+    markDirty(x0, y0, x1, y1);
+    return;
   }
-  for (int16_t row = 0; row < spanHeight; ++row) {
-    writeData(lineBuf, bytesPerLine);
+
+  if (roundClip_) {
+    forEachVisibleBand(x0, y0, x1, y1, [&](int16_t a, int16_t top, int16_t b, int16_t bottom) {
+      setAddrWindow(a, top, b, bottom);
+      writeData16Repeat(color, static_cast<size_t>(b - a + 1) * (bottom - top + 1));
+    });
+    return;
   }
-  endWrite();
+
+  setAddrWindow(x0, y0, x1, y1);
+  writeData16Repeat(color, static_cast<size_t>(spanWidth) * spanHeight);
 }
 
-void Gc9a01Graphics::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-  if (w <= 0 || h <= 0) return;
-  drawFastHLine(x, y, w, color);
-  drawFastHLine(x, y + h - 1, w, color);
-  if (h > 2) {
-    drawFastVLine(x, y + 1, h - 2, color);
-    drawFastVLine(x + w - 1, y + 1, h - 2, color);
-  }
+void Gc9a01Graphics::fillSpan(int16_t x0, int16_t x1, int16_t y, uint16_t color) {
+  fillLogicalRect(x0, y, x1, y, color);
+}
+
+void Gc9a01Graphics::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  fillLogicalRect(x, y, x, y, color);
 }
 
-void Gc9a01Graphics::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
-  if (h <= 0) return;
-  if (x < 0 || x >= width_) return;
-  if (y < 0) {
-    h += y;
-    y = 0;
+void Gc9a01Graphics::fillSpans(const Span *spans, uint16_t count, uint16_t color) {
+  if (!spans) return;
+  batchColor_ = color;
+  for (uint16_t i = 0; i < count; ++i) {
+    batchLogicalRect(spans[i].x0, spans[i].y, spans[i].x1, spans[i].y);
   }
-  if (y + h > height_) {
-    h = height_ - y;
+  sendBatch();
+}
+
+void Gc9a01Graphics::fillRects(const Rect *rects, uint16_t count, uint16_t color) {
+  if (!rects) return;
+  batchColor_ = color;
+  for (uint16_t i = 0; i < count; ++i) {
+    const Rect &rect = rects[i];
+    if (rect.w <= 0 || rect.h <= 0) continue;
+    batchLogicalRect(rect.x, rect.y, rect.x + rect.w - 1, rect.y + rect.h - 1);
   }
-  if (h <= 0) return;
-  startWrite();
-  setAddrWindow(x, y, x, y + h - 1);
-  writeData16Repeat(color, h);
-  endWrite();
+  sendBatch();
 }
 
-void Gc9a01Graphics::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
-  if (w <= 0) return;
-  fillSpan(x, x + w - 1, y, color);
+void Gc9a01Graphics::drawPolyline(const Point *points, uint8_t count, uint8_t width, uint16_t color) {
+  batchColor_ = color;
+  raster::polyline(points, count, width, BatchSink{*this});
+  sendBatch();
 }
 
-void Gc9a01Graphics::fillSpanInternal(int16_t x0, int16_t x1, int16_t y, uint16_t color) {
-  if (y < 0 || y >= height_) return;
-  if (x0 > x1) std::swap(x0, x1);
-  if (x1 < 0 || x0 >= width_) return;
-  if (x0 < 0) x0 = 0;
-  if (x1 >= width_) x1 = width_ - 1;
-  startWrite();
-  setAddrWindow(x0, y, x1, y);
-  int count = x1 - x0 + 1;
-  writeData16Repeat(color, count);
-  endWrite();
+void Gc9a01Graphics::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  batchColor_ = color;
+  raster::lineRuns(x0, y0, x1, y1, BatchSink{*this});
+  sendBatch();
 }
 
-void Gc9a01Graphics::fillSpan(int16_t x0, int16_t x1, int16_t y, uint16_t color) {
-  fillSpanInternal(x0, x1, y, color);
+void Gc9a01Graphics::batchLogicalRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  if (x0 > x1) std::swap(x0, x1);
+  if (y0 > y1) std::swap(y0, y1);
+  if (x1 < 0 || y1 < 0 || x0 >= width_ || y0 >= height_) return;
+  x0 = std::max<int16_t>(x0, 0);
+  y0 = std::max<int16_t>(y0, 0);
+  x1 = std::min<int16_t>(x1, width_ - 1);
+  y1 = std::min<int16_t>(y1, height_ - 1);
+  rotateRect(x0, y0, x1, y1, panelTurns_, kScreenSize);
+  if (!clips_.clip(x0, y0, x1, y1)) return;
+  if (batchCount_ == kMaxBatchRects) {
+    sendBatch();
+  }
+  batch_[batchCount_++] = DirtyRect{x0, y0, x1, y1};
 }
 
-void Gc9a01Graphics::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if (x < 0 || y < 0 || x >= width_ || y >= height_) return;
-  startWrite();
-  setAddrWindow(x, y, x, y);
-  writeData16(color);
-  endWrite();
-}
-
-void Gc9a01Graphics::pushPixels(const uint16_t *pixels, size_t count) {
-  constexpr size_t kChunk = 64;
-  uint8_t buffer[kChunk * 2];
-  while (count > 0) {
-    size_t batch = std::min(count, kChunk);
-    for (size_t i = 0; i < batch; ++i) {
-      uint16_t value = pixels[i];
-      buffer[2 * i]     = static_cast<uint8_t>(value >> 8);
-      buffer[2 * i + 1] = static_cast<uint8_t>(value & 0xFF);
+void Gc9a01Graphics::sendBatch() {
+  if (batchCount_ == 0) return;
+  DirtyRect *const begin = batch_;
+  DirtyRect *end = batch_ + batchCount_;
+
+  // Row order first, so pieces of the same rows that touch or overlap
+  // become one rect...
+  std::sort(begin, end, [](const DirtyRect &a, const DirtyRect &b) {
+    if (a.y0 != b.y0) return a.y0 < b.y0;
+    if (a.y1 != b.y1) return a.y1 < b.y1;
+    return a.x0 < b.x0;
+  });
+  DirtyRect *out = begin;
+  for (DirtyRect *rect = begin + 1; rect < end; ++rect) {
+    if (rect->y0 == out->y0 && rect->y1 == out->y1 && rect->x0 <= out->x1 + 1) {
+      out->x1 = std::max(out->x1, rect->x1);
+    } else {
+      *++out = *rect;
+    }
+  }
+  end = out + 1;
+
+  // ...then column order, so equal pieces on consecutive rows stack into
+  // one window, as the steps of a steep line do.
+  std::sort(begin, end, [](const DirtyRect &a, const DirtyRect &b) {
+    if (a.x0 != b.x0) return a.x0 < b.x0;
+    if (a.x1 != b.x1) return a.x1 < b.x1;
+    return a.y0 < b.y0;
+  });
+  out = begin;
+  for (DirtyRect *rect = begin + 1; rect < end; ++rect) {
+    if (rect->x0 == out->x0 && rect->x1 == out->x1 && rect->y0 <= out->y1 + 1) {
+      out->y1 = std::max(out->y1, rect->y1);
+    } else {
+      *++out = *rect;
     }
-    writeData(buffer, batch * 2);
-    pixels += batch;
-    count  -= batch;
   }
+  end = out + 1;
+
+  for (const DirtyRect *rect = begin; rect < end; ++rect) {
+    fillPanelRect(rect->x0, rect->y0, rect->x1, rect->y1, batchColor_);
+  }
+  batchCount_ = 0;
 }
 
+void Gc9a01Graphics::pushClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  clips_.push(x0, y0, x1, y1, panelTurns_);
+}
 
-void Gc9a01Graphics::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
-  if (x0 == x1) {
-    if (y0 > y1) std::swap(y0, y1);
-    drawFastVLine(x0, y0, y1 - y0 + 1, color);
-    return;
-  }
-  if (y0 == y1) {
-    if (x0 > x1) std::swap(x0, x1);
-    drawFastHLine(x0, y0, x1 - x0 + 1, color);
-    return;
-  }
+void Gc9a01Graphics::popClip() {
+  clips_.pop();
+}
+
+uint8_t Gc9a01Graphics::getRotation() const {
+  return rotation_;
+}
 
-  int16_t dx = std::abs(x1 - x0);
-  int16_t sx = x0 < x1 ? 1 : -1;
-  int16_t dy = -std::abs(y1 - y0);
-  int16_t sy = y0 < y1 ? 1 : -1;
-  int16_t err = dx + dy;
+void Gc9a01Graphics::setRotation(uint8_t rotation) {
+  // Only the coordinate transform changes; the panel keeps scanning the same
+  // way, so rotated and upright content can share one flush.
+  rotation_ = rotation % 4;
+  panelTurns_ = static_cast<uint8_t>((rotation_ + 4 - kPanelRotation) % 4);
+}
 
-  while (true) {
-    drawPixel(x0, y0, color);
-    if (x0 == x1 && y0 == y1) break;
-    int16_t e2 = err << 1;
-    if (e2 >= dy) {
-      err += dy;
-      x0 += sx;
+void Gc9a01Graphics::drawTextBox(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 int16_t textX, int16_t textY,
+                                 const char *text,
+                                 uint16_t colorText, uint16_t colorBG,
+                                 uint8_t textSize) {
+  if (!text || w <= 0 || h <= 0) return;
+  const int16_t x0 = std::max<int16_t>(x, 0);
+  const int16_t y0 = std::max<int16_t>(y, 0);
+  const int16_t x1 = std::min<int16_t>(x + w - 1, width_ - 1);
+  const int16_t y1 = std::min<int16_t>(y + h - 1, height_ - 1);
+  if (x0 > x1 || y0 > y1) return;
+
+  const TextRun run{textX, textY, text, std::strcspn(text, "\n"),
+                    toPanelOrder(colorText), toPanelOrder(colorBG), font5x7::scaleFor(textSize)};
+
+  int16_t px0 = x0, py0 = y0, px1 = x1, py1 = y1;
+  rotateRect(px0, py0, px1, py1, panelTurns_, kScreenSize);
+  if (!clips_.clip(px0, py0, px1, py1)) return;
+  const uint8_t inverseTurns = static_cast<uint8_t>((4 - panelTurns_) % 4);
+
+  if (target_) {
+    // Only the panel rows the target holds are rendered; map them back to
+    // the logical rect that covers them.
+    py0 = std::max(py0, targetTop_);
+    py1 = std::min(py1, targetBottom_);
+    if (py0 > py1) return;
+    int16_t lx0 = px0, ly0 = py0, lx1 = px1, ly1 = py1;
+    rotateRect(lx0, ly0, lx1, ly1, inverseTurns, kScreenSize);
+
+    awaitFramebuffer();
+    const ptrdiff_t stride = rotatedStride(panelTurns_, kScreenSize);
+    for (int16_t row = ly0; row <= ly1; ++row) {
+      int16_t px = lx0, py = row;
+      rotatePoint(px, py, panelTurns_, kScreenSize);
+      renderTextRow(target_ + (py - targetTop_) * kScreenSize + px, stride, lx0, lx1, row, run);
     }
-    if (e2 <= dx) {
-      err += dx;
-      y0 += sy;
+    markDirty(px0, py0, px1, py1);
+    return;
+  }
+
+  // Panel rows are rendered straight into staging buffers in wire order, so
+  // the whole box leaves in one window however many glyphs it holds. Each
+  // band of panel rows maps back to a logical rect whose rows are written
+  // with the rotated stride.
+  setAddrWindow(px0, py0, px1, py1);
+  const int16_t pitch = px1 - px0 + 1;
+  const int16_t rowsPerBuffer = stagedRowsPerBuffer(pitch);
+  const ptrdiff_t stride = rotatedStride(panelTurns_, pitch);
+  for (int16_t bandY0 = py0; bandY0 <= py1; bandY0 += rowsPerBuffer) {
+    const int16_t bandY1 = std::min<int16_t>(bandY0 + rowsPerBuffer - 1, py1);
+    int16_t lx0 = px0, ly0 = bandY0, lx1 = px1, ly1 = bandY1;
+    rotateRect(lx0, ly0, lx1, ly1, inverseTurns, kScreenSize);
+
+    uint16_t *band = reinterpret_cast<uint16_t *>(bus_.stagingBuffer());
+    for (int16_t row = ly0; row <= ly1; ++row) {
+      int16_t px = lx0, py = row;
+      rotatePoint(px, py, panelTurns_, kScreenSize);
+      renderTextRow(band + (py - bandY0) * pitch + (px - px0), stride, lx0, lx1, row, run);
     }
+    submitStagedPixels(band, static_cast<size_t>(bandY1 - bandY0 + 1) * pitch);
   }
 }
 
-void Gc9a01Graphics::fillTriangle(int16_t x0, int16_t y0,
-                                  int16_t x1, int16_t y1,
-                                  int16_t x2, int16_t y2,
-                                  uint16_t color) {
-  if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
-  if (y1 > y2) { std::swap(y1, y2); std::swap(x1, x2); }
-  if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
-
-  auto edgeInterpolate = [](int16_t y0, int16_t x0, int16_t y1, int16_t x1, int16_t y) -> int16_t {
-    if (y1 == y0) return x0;
-    return x0 + (int32_t)(x1 - x0) * (y - y0) / (y1 - y0);
-  };
+void Gc9a01Graphics::drawRows(int16_t x, int16_t y, int16_t w, int16_t h, RowSource source, void *context) {
+  if (!source || w <= 0 || h <= 0) return;
+  const int16_t x0 = std::max<int16_t>(x, 0);
+  const int16_t y0 = std::max<int16_t>(y, 0);
+  const int16_t x1 = std::min<int16_t>(x + w - 1, width_ - 1);
+  const int16_t y1 = std::min<int16_t>(y + h - 1, height_ - 1);
+  if (x0 > x1 || y0 > y1) return;
+
+  int16_t px0 = x0, py0 = y0, px1 = x1, py1 = y1;
+  rotateRect(px0, py0, px1, py1, panelTurns_, kScreenSize);
+  if (!clips_.clip(px0, py0, px1, py1)) return;
+  uint16_t row[kScreenSize];
+
+  if (target_) {
+    // As with text, only the logical rect behind the target's rows is read.
+    py0 = std::max(py0, targetTop_);
+    py1 = std::min(py1, targetBottom_);
+    if (py0 > py1) return;
+    int16_t lx0 = px0, ly0 = py0, lx1 = px1, ly1 = py1;
+    rotateRect(lx0, ly0, lx1, ly1, static_cast<uint8_t>((4 - panelTurns_) % 4), kScreenSize);
+
+    awaitFramebuffer();
+    const ptrdiff_t stride = rotatedStride(panelTurns_, kScreenSize);
+    for (int16_t ly = ly0; ly <= ly1; ++ly) {
+      source(context, ly, lx0, lx1, row);
+      int16_t px = lx0, py = ly;
+      rotatePoint(px, py, panelTurns_, kScreenSize);
+      uint16_t *dest = target_ + (py - targetTop_) * kScreenSize + px;
+      storeWireRow(dest, stride, row, lx1 - lx0 + 1);
+    }
+    markDirty(px0, py0, px1, py1);
+    return;
+  }
 
-  for (int16_t y = y0; y <= y1; ++y) {
-    int16_t xa = edgeInterpolate(y0, x0, y2, x2, y);
-    int16_t xb = edgeInterpolate(y0, x0, y1, x1, y);
-    fillSpan(xa, xb, y, color);
-  }
-  for (int16_t y = y1 + 1; y <= y2; ++y) {
-    int16_t xa = edgeInterpolate(y0, x0, y2, x2, y);
-    int16_t xb = edgeInterpolate(y1, x1, y2, x2, y);
-    fillSpan(xa, xb, y, color);
-  }
-}
-
-void Gc9a01Graphics::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
-  drawFastHLine(x0 - r, y0, 2 * r + 1, color);
-  int16_t f = 1 - r;
-  int16_t ddF_x = 1;
-  int16_t ddF_y = -2 * r;
-  int16_t x = 0;
-  int16_t y = r;
-
-  while (x < y) {
-    if (f >= 0) {
-      y--;
-      ddF_y += 2;
-      f += ddF_y;
+  if (panelTurns_ == 0) {
+    // Logical rows are panel rows, so the block streams in one window.
+    WireRowSource adapter{source, context};
+    pushRows(px0, py0, px1, py1, WireRowSource::read, &adapter);
+    return;
+  }
+  // Rotated rows run down panel columns. As with text boxes, each band of
+  // panel rows is built from the logical rows behind it, written with the
+  // rotated stride, so the block still leaves in one window.
+  setAddrWindow(px0, py0, px1, py1);
+  const int16_t pitch = px1 - px0 + 1;
+  const int16_t rowsPerBuffer = stagedRowsPerBuffer(pitch);
+  const ptrdiff_t stride = rotatedStride(panelTurns_, pitch);
+  const uint8_t inverseTurns = static_cast<uint8_t>((4 - panelTurns_) % 4);
+  for (int16_t bandY0 = py0; bandY0 <= py1; bandY0 += rowsPerBuffer) {
+    const int16_t bandY1 = std::min<int16_t>(bandY0 + rowsPerBuffer - 1, py1);
+    int16_t lx0 = px0, ly0 = bandY0, lx1 = px1, ly1 = bandY1;
+    rotateRect(lx0, ly0, lx1, ly1, inverseTurns, kScreenSize);
+
+    uint16_t *band = reinterpret_cast<uint16_t *>(bus_.stagingBuffer());
+    for (int16_t ly = ly0; ly <= ly1; ++ly) {
+      source(context, ly, lx0, lx1, row);
+      int16_t px = lx0, py = ly;
+      rotatePoint(px, py, panelTurns_, kScreenSize);
+      uint16_t *dest = band + (py - bandY0) * pitch + (px - px0);
+      storeWireRow(dest, stride, row, lx1 - lx0 + 1);
     }
-    x++;
-    ddF_x += 2;
-    f += ddF_x;
+    submitStagedPixels(band, static_cast<size_t>(bandY1 - bandY0 + 1) * pitch);
+  }
+}
 
-    drawFastHLine(x0 - x, y0 + y, 2 * x + 1, color);
-    drawFastHLine(x0 - x, y0 - y, 2 * x + 1, color);
-    drawFastHLine(x0 - y, y0 + x, 2 * y + 1, color);
-    drawFastHLine(x0 - y, y0 - x, 2 * y + 1, color);
+void Gc9a01Graphics::pushRows(int16_t x0, int16_t y0, int16_t x1, int16_t y1, RowSource source, void *context) {
+  if (!source) return;
+  x0 = std::max<int16_t>(x0, 0);
+  y0 = std::max<int16_t>(y0, 0);
+  x1 = std::min<int16_t>(x1, kScreenSize - 1);
+  y1 = std::min<int16_t>(y1, kScreenSize - 1);
+  if (x0 > x1 || y0 > y1) return;
+
+  auto push = [&](int16_t a, int16_t top, int16_t b, int16_t bottom) {
+    setAddrWindow(a, top, b, bottom);
+    const int16_t pitch = b - a + 1;
+    const int16_t rowsPerBuffer = stagedRowsPerBuffer(pitch);
+    for (int16_t bandY0 = top; bandY0 <= bottom; bandY0 += rowsPerBuffer) {
+      const int16_t bandY1 = std::min<int16_t>(bandY0 + rowsPerBuffer - 1, bottom);
+      uint16_t *band = reinterpret_cast<uint16_t *>(bus_.stagingBuffer());
+      for (int16_t y = bandY0; y <= bandY1; ++y) {
+        source(context, y, a, b, band + (y - bandY0) * pitch);
+      }
+      submitStagedPixels(band, static_cast<size_t>(bandY1 - bandY0 + 1) * pitch);
+    }
+  };
+  if (roundClip_) {
+    forEachVisibleBand(x0, y0, x1, y1, push);
+  } else {
+    push(x0, y0, x1, y1);
   }
 }
 
-uint8_t Gc9a01Graphics::getRotation() const {
-  return rotation_;
+int16_t Gc9a01Graphics::stagedRowsPerBuffer(int16_t pitch) const {
+  int16_t rows = static_cast<int16_t>(SpiDmaBus::kStagingBytes / (pitch * 2));
+  if (pixelFormat_ == PixelFormat::Rgb444 && (pitch & 1)) {
+    // Packed buffers must hold whole pixel pairs to chain on the wire.
+    rows &= ~1;
+  }
+  return rows;
 }
 
-void Gc9a01Graphics::setRotation(uint8_t rotation) {
-  rotation_ = rotation % 4;
-  uint8_t madctl;
-  switch (rotation_) {
-    case 0:
-      madctl = 0x08;  // BGR
-      break;
-    case 1:
-      madctl = 0x68;  // MX | MV | BGR
-      break;
-    case 2:
-      madctl = 0xC8;  // MX | MY | BGR
-      break;
-    case 3:
-    default:
-      madctl = 0xA8;  // MY | MV | BGR
-      break;
-  }
-  width_ = kScreenSize;
-  height_ = kScreenSize;
-  writeCommandWithData(0x36, &madctl, 1);
-}
-
-void Gc9a01Graphics::drawChar(int16_t x, int16_t y, char c,
-                              uint16_t colorText, uint16_t colorBG,
-                              uint8_t textSize) {
-  if (c < 0x20 || c > 0x7F) {
-    c = '?';
-  }
-  if (textSize == 0) {
+void Gc9a01Graphics::submitStagedPixels(uint16_t *pixels, size_t count) {
+  if (pixelFormat_ == PixelFormat::Rgb444) {
+    Rgb444Packer packer(reinterpret_cast<uint8_t *>(pixels));
+    packer.push(pixels, count);
+    bus_.submitStaging(packer.finish());
     return;
   }
+  bus_.submitStaging(count * 2);
+}
 
-  constexpr int kBaseW = 6;
-  constexpr int kBaseH = 8;
-  constexpr int kMaxScale = 4;
-  static uint16_t glyphPixels[kBaseW * kBaseH * kMaxScale * kMaxScale];
+void Gc9a01Graphics::markDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  if (target_ != framebuffer_) return;  // Bands are always sent whole.
+  addMergedRect<kDirtyMergeSlackPixels>(dirty_, dirtyCount_, DirtyRect{x0, y0, x1, y1});
+}
 
-  int scale = textSize;
-  if (scale > kMaxScale) {
-    scale = kMaxScale;
+void Gc9a01Graphics::flush() {
+  if (!framebuffer_ || dirtyCount_ == 0) return;
+
+  for (uint8_t i = 0; i < dirtyCount_; ++i) {
+    const DirtyRect &rect = dirty_[i];
+    if (shown_) {
+      sendChangedRows(rect.x0, rect.y0, rect.x1, rect.y1);
+    } else if (roundClip_) {
+      forEachVisibleBand(rect.x0, rect.y0, rect.x1, rect.y1, [&](int16_t a, int16_t top, int16_t b, int16_t bottom) {
+        sendFramebufferRect(a, top, b, bottom);
+      });
+    } else {
+      sendFramebufferRect(rect.x0, rect.y0, rect.x1, rect.y1);
+    }
+  }
+  dirtyCount_ = 0;
+  if (shown_) {
+    // A full-screen dirty rect was part of this flush whenever the copy was
+    // stale, so it now matches the panel.
+    shownValid_ = true;
   }
+}
 
-  const int glyphW = kBaseW * scale;
-  const int glyphH = kBaseH * scale;
-  const size_t totalPixels = static_cast<size_t>(glyphW) * static_cast<size_t>(glyphH);
+void Gc9a01Graphics::sendChangedRows(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  // Windows still growing, for the previous and the current row.
+  DiffWindow windows[2][kMaxDiffRuns];
+  uint8_t windowCount[2] = {0, 0};
 
-  std::fill_n(glyphPixels, totalPixels, colorBG);
+  for (int16_t y = y0; y <= y1; ++y) {
+    int16_t a = x0;
+    int16_t b = x1;
+    if (roundClip_) {
+      a = std::max<int16_t>(a, kVisibleRows.min[y]);
+      b = std::min<int16_t>(b, kVisibleRows.max[y]);
+    }
+    const uint16_t *row = framebuffer_ + y * kScreenSize;
+    uint16_t *previous = shown_ + y * kScreenSize;
+    DiffRun runs[kMaxDiffRuns];
+    uint8_t runCount = 0;
+    if (a <= b) {
+      if (shownValid_) {
+        runCount = findChangedRuns(row, previous, a, b, runs);
+      } else {
+        runs[0] = DiffRun{a, b};
+        runCount = 1;
+      }
+    }
+    for (uint8_t i = 0; i < runCount; ++i) {
+      std::memcpy(previous + runs[i].x0, row + runs[i].x0, (runs[i].x1 - runs[i].x0 + 1) * sizeof(uint16_t));
+    }
 
-  const uint8_t *glyph = kFont5x7[c - 0x20];
-  for (int col = 0; col < 5; ++col) {
-    uint8_t bits = glyph[col];
-    for (int row = 0; row < 7; ++row) {
-      if (bits & (1 << row)) {
-        for (int dy = 0; dy < scale; ++dy) {
-          uint16_t *dest = glyphPixels + (row * scale + dy) * glyphW + col * scale;
-          for (int dx = 0; dx < scale; ++dx) {
-            dest[dx] = colorText;
-          }
+    // A run that overlaps a window from the row above extends it when the
+    // taller window wastes little; windows left without a run are done.
+    const DiffWindow *above = windows[(y + 1) & 1];
+    const uint8_t aboveCount = windowCount[(y + 1) & 1];
+    DiffWindow *current = windows[y & 1];
+    uint8_t &currentCount = windowCount[y & 1];
+    currentCount = 0;
+    uint8_t p = 0;
+    for (uint8_t i = 0; i < runCount; ++i) {
+      const DiffRun &run = runs[i];
+      while (p < aboveCount && above[p].x1 < run.x0) {
+        sendFramebufferRect(above[p].x0, above[p].y0, above[p].x1, y - 1);
+        ++p;
+      }
+      DiffWindow next{run.x0, run.x1, y, run.x1 - run.x0 + 1};
+      if (p < aboveCount && above[p].x0 <= run.x1) {
+        const DiffWindow &window = above[p++];
+        const int16_t ux0 = std::min(window.x0, run.x0);
+        const int16_t ux1 = std::max(window.x1, run.x1);
+        const int32_t used = window.used + next.used;
+        if (static_cast<int32_t>(ux1 - ux0 + 1) * (y - window.y0 + 1) - used <= kDiffStackSlackPixels) {
+          next = DiffWindow{ux0, ux1, window.y0, used};
+        } else {
+          sendFramebufferRect(window.x0, window.y0, window.x1, y - 1);
         }
       }
+      current[currentCount++] = next;
+    }
+    for (; p < aboveCount; ++p) {
+      sendFramebufferRect(above[p].x0, above[p].y0, above[p].x1, y - 1);
     }
   }
-
-  startWrite();
-  setAddrWindow(x, y, x + glyphW - 1, y + glyphH - 1);
-  pushPixels(glyphPixels, totalPixels);
-  endWrite();
+  const uint8_t last = y1 & 1;
+  for (uint8_t i = 0; i < windowCount[last]; ++i) {
+    sendFramebufferRect(windows[last][i].x0, windows[last][i].y0, windows[last][i].x1, y1);
+  }
 }
 
-void Gc9a01Graphics::drawText(int16_t x, int16_t y,
-                              const char *text,
-                              uint16_t colorText, uint16_t colorBG,
-                              uint8_t textSize) {
-  if (!text) return;
-
-  constexpr int kBaseW = 6;
-  constexpr int kBaseH = 8;
-  constexpr int kMaxScale = 4;
-  int scale = textSize == 0 ? 1 : textSize;
-  if (scale > kMaxScale) {
-    scale = kMaxScale;
+void Gc9a01Graphics::sendFramebufferRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  setAddrWindow(x0, y0, x1, y1);
+  const size_t rowBytes = static_cast<size_t>(x1 - x0 + 1) * 2;
+  const uint16_t *row = target_ + (y0 - targetTop_) * kScreenSize + x0;
+  if (pixelFormat_ == PixelFormat::Rgb444) {
+    sendFramebufferRect444(row, x1 - x0 + 1, y1 - y0 + 1);
+    return;
+  }
+  if (x0 == 0 && x1 == kScreenSize - 1) {
+    // Contiguous rows go straight from the framebuffer or band by DMA.
+    bus_.writeDma(reinterpret_cast<const uint8_t *>(row), rowBytes * (y1 - y0 + 1));
+    framebufferInFlight_ = true;
+    return;
+  }
+  // Strided rows are packed into staging buffers to keep transfers large.
+  const size_t rowsPerBuffer = SpiDmaBus::kStagingBytes / rowBytes;
+  int16_t y = y0;
+  while (y <= y1) {
+    uint8_t *dest = bus_.stagingBuffer();
+    size_t packed = 0;
+    for (; packed < rowsPerBuffer && y <= y1; ++packed, ++y, row += kScreenSize) {
+      std::memcpy(dest + packed * rowBytes, row, rowBytes);
+    }
+    bus_.submitStaging(packed * rowBytes);
   }
-  const int advance = kBaseW * scale;
-  const int lineAdvance = kBaseH * scale;
+}
 
-  int16_t cursorX = x;
-  while (*text) {
-    if (*text == '\n') {
-      cursorX = x;
-      y += lineAdvance;
-      ++text;
-      continue;
+void Gc9a01Graphics::sendFramebufferRect444(const uint16_t *row, int16_t width, int16_t height) {
+  // The framebuffer stays RGB565; rows are converted while packing. Each
+  // buffer but the last holds an even pixel count so pairs never straddle.
+  const size_t pairsPerBuffer = SpiDmaBus::kStagingBytes / 3;
+  size_t rowsPerBuffer = (pairsPerBuffer * 2) / width;
+  if (width & 1) {
+    rowsPerBuffer &= ~static_cast<size_t>(1);
+  }
+  int16_t y = 0;
+  while (y < height) {
+    Rgb444Packer packer(bus_.stagingBuffer());
+    for (size_t packed = 0; packed < rowsPerBuffer && y < height; ++packed, ++y, row += kScreenSize) {
+      packer.push(row, width);
     }
-    drawChar(cursorX, y, *text, colorText, colorBG, scale);
-    cursorX += advance;
-    ++text;
+    bus_.submitStaging(packer.finish());
   }
 }
 
 void Gc9a01Graphics::displayOn() {
   writeCommand(0x11);
+  bus_.waitIdle();
   delay(120);
   writeCommand(0x29);
+  bus_.waitIdle();
   delay(20);
-  setRotation(rotation_);
+  writeCommandWithData(0x36, &kPanelMadctl, 1);
 }
 
 void Gc9a01Graphics::displayOff() {
   writeCommand(0x28);
+  bus_.waitIdle();
   delay(20);
   writeCommand(0x10);
+  bus_.waitIdle();
   delay(120);
 }
 
@@ -0,0 +1,164 @@
+#include "image_pack.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "debug_log.h"
+#include "esp_partition.h"
+#include "pixel_kernels.h"
+
+namespace image_pack {
+namespace {
+
+constexpr char kMagic[4] = {'H', 'I', 'M', 'G'};
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderBytes = 12;
+constexpr size_t kNameBytes = 16;
+constexpr size_t kEntryBytes = kNameBytes + 8;
+// Data partition subtype of `images` in partitions.csv.
+constexpr esp_partition_subtype_t kPartitionSubtype = static_cast<esp_partition_subtype_t>(0x40);
+
+const uint8_t *s_pack = nullptr;
+uint16_t s_count = 0;
+// The pack's total size; nothing at or past it is read.
+uint32_t s_total = 0;
+
+// Flash is read a byte at a time: the format packs pixels at odd offsets
+// and the core faults on unaligned wider loads.
+inline uint16_t read16(const uint8_t *p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t read32(const uint8_t *p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Whether every row of `image` decodes before `end`. readRow does not
+// check as it goes, so imageAt walks each row's ops once here instead.
+bool rowsFit(const Image &image, const uint8_t *end) {
+  for (uint16_t y = 0; y < image.height; ++y) {
+    const uint32_t offset = read32(image.rowOffsets + y * 4);
+    if (offset >= static_cast<size_t>(end - image.rows)) return false;
+    const uint8_t *op = image.rows + offset;
+    for (uint32_t x = 0; x < image.width;) {
+      if (op == end) return false;
+      const uint8_t code = *op++;
+      const size_t length = (code & 0x7F) + 1;
+      const size_t bytes = (code & 0x80) ? 2 : 2 * length;
+      if (bytes > static_cast<size_t>(end - op)) return false;
+      op += bytes;
+      x += length;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool begin() {
+  if (s_pack) return true;
+  const esp_partition_t *partition =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, kPartitionSubtype, "images");
+  if (!partition) {
+    LOG_PRINT(1, "[images] no images partition");
+    return false;
+  }
+  const void *mapped = nullptr;
+  esp_partition_mmap_handle_t handle;
+  if (esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+    LOG_PRINT(1, "[images] partition not mapped");
+    return false;
+  }
+  const uint8_t *pack = static_cast<const uint8_t *>(mapped);
+  const uint16_t count = read16(pack + 6);
+  const uint32_t total = read32(pack + 8);
+  if (std::memcmp(pack, kMagic, sizeof(kMagic)) != 0 || read16(pack + 4) != kVersion ||
+      total > partition->size || kHeaderBytes + count * kEntryBytes > total) {
+    LOG_PRINT(1, "[images] partition holds no image pack");
+    esp_partition_munmap(handle);
+    return false;
+  }
+  s_pack = pack;
+  s_count = count;
+  s_total = total;
+  LOG_PRINTF(1, "[images] %u image(s), %lu B\n", static_cast<unsigned>(count), static_cast<unsigned long>(total));
+  return true;
+}
+
+uint16_t count() {
+  return s_count;
+}
+
+bool imageAt(uint16_t index, Image &image) {
+  if (index >= s_count) return false;
+  const uint8_t *entry = s_pack + kHeaderBytes + index * kEntryBytes;
+  Image found;
+  found.width = read16(entry + kNameBytes);
+  found.height = read16(entry + kNameBytes + 2);
+  const uint32_t offset = read32(entry + kNameBytes + 4);
+  // A truncated or corrupt pack must not send readRow past the mapping.
+  if (offset > s_total || found.height * 4u > s_total - offset) {
+    LOG_PRINTF(1, "[images] image %u lies outside the pack\n", static_cast<unsigned>(index));
+    return false;
+  }
+  found.rowOffsets = s_pack + offset;
+  found.rows = found.rowOffsets + found.height * 4;
+  if (!rowsFit(found, s_pack + s_total)) {
+    LOG_PRINTF(1, "[images] image %u has rows outside the pack\n", static_cast<unsigned>(index));
+    return false;
+  }
+  found.x = image.x;
+  found.y = image.y;
+  image = found;
+  return true;
+}
+
+bool find(const char *name, Image &image) {
+  if (!name) return false;
+  for (uint16_t i = 0; i < s_count; ++i) {
+    const char *entryName = reinterpret_cast<const char *>(s_pack + kHeaderBytes + i * kEntryBytes);
+    if (std::strncmp(entryName, name, kNameBytes) == 0) return imageAt(i, image);
+  }
+  return false;
+}
+
+void drawImage(graphics::Graphics &display, const Image &image) {
+  if (!image.rows) return;
+  display.drawRows(image.x, image.y, image.width, image.height, readRow, const_cast<Image *>(&image));
+}
+
+void unpack(const Image &image, uint16_t *dest) {
+  if (!image.rows || !dest) return;
+  Image origin = image;
+  origin.x = 0;
+  origin.y = 0;
+  for (uint16_t y = 0; y < image.height; ++y) {
+    readRow(&origin, static_cast<int16_t>(y), 0, static_cast<int16_t>(image.width - 1), dest + y * image.width);
+  }
+}
+
+void readRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest) {
+  const Image &image = *static_cast<const Image *>(context);
+  const uint8_t *op = image.rows + read32(image.rowOffsets + (y - image.y) * 4);
+  // Ops left of x0 are skipped without touching their pixels.
+  int16_t x = image.x;
+  while (x <= x1) {
+    const uint8_t code = *op++;
+    const int16_t length = static_cast<int16_t>((code & 0x7F) + 1);
+    const int16_t a = std::max(x, x0);
+    const int16_t b = std::min<int16_t>(x + length - 1, x1);
+    if (code & 0x80) {
+      if (a <= b) graphics::pixels::fill(dest + (a - x0), read16(op), b - a + 1);
+      op += 2;
+    } else {
+      for (int16_t i = a; i <= b; ++i) {
+        dest[i - x0] = read16(op + 2 * (i - x));
+      }
+      op += 2 * length;
+    }
+    x = static_cast<int16_t>(x + length);
+  }
+}
+
+}  // namespace image_pack
@@ -0,0 +1,294 @@
+#include "indexed_canvas.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "esp_heap_caps.h"
+#include "font5x7.h"
+#include "gc9a01_graphics.h"
+#include "graphics_utils.h"
+#include "pixel_kernels.h"
+
+namespace graphics {
+namespace {
+
+// Dirty rows share one window while the bounding box sends no more than
+// this many unchanged pixels.
+constexpr int32_t kFlushSlackPixels = 64;
+
+inline uint16_t toWireOrder(uint16_t color) {
+  return static_cast<uint16_t>((color >> 8) | (color << 8));
+}
+
+// Squared RGB565 channel distance, green weighted to match its extra bit.
+inline int32_t colorDistance(uint16_t a, uint16_t b) {
+  const int32_t dr = ((a >> 11) & 0x1F) - ((b >> 11) & 0x1F);
+  const int32_t dg = ((a >> 5) & 0x3F) - ((b >> 5) & 0x3F);
+  const int32_t db = (a & 0x1F) - (b & 0x1F);
+  return 4 * dr * dr + dg * dg + 4 * db * db;
+}
+
+}  // namespace
+
+IndexedCanvas::IndexedCanvas(Gc9a01Graphics &panel, uint8_t bitsPerPixel)
+    : IndexedCanvas(bitsPerPixel) {
+  panel_ = &panel;
+}
+
+IndexedCanvas::IndexedCanvas(uint8_t bitsPerPixel)
+    : panel_(nullptr),
+      bits_(bitsPerPixel == 4 ? 4 : 8),
+      pitch_(bits_ == 4 ? kSize / 2 : kSize),
+      rotation_(Gc9a01Graphics::kPanelRotation) {
+  clearPalette();
+  invalidate();
+}
+
+IndexedCanvas::~IndexedCanvas() {
+  heap_caps_free(pixels_);
+}
+
+bool IndexedCanvas::begin() {
+  if (pixels_) return true;
+  pixels_ = static_cast<uint8_t *>(heap_caps_malloc(pitch_ * kSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  if (!pixels_) return false;
+  std::memset(pixels_, 0, pitch_ * kSize);
+  invalidate();
+  return true;
+}
+
+void IndexedCanvas::clearPalette() {
+  keys_[0] = 0x0000;
+  shown_[0] = 0x0000;
+  used_ = 1;
+}
+
+bool IndexedCanvas::setShownColor(uint16_t color, uint16_t shown) {
+  for (uint16_t i = 0; i < used_; ++i) {
+    if (keys_[i] != color) continue;
+    if (shown_[i] != toWireOrder(shown)) {
+      shown_[i] = toWireOrder(shown);
+      invalidate();
+    }
+    return true;
+  }
+  return false;
+}
+
+void IndexedCanvas::restoreShownColors() {
+  for (uint16_t i = 0; i < used_; ++i) {
+    shown_[i] = toWireOrder(keys_[i]);
+  }
+  invalidate();
+}
+
+void IndexedCanvas::invalidate() {
+  std::fill_n(dirtyMin_, kSize, 0);
+  std::fill_n(dirtyMax_, kSize, kSize - 1);
+}
+
+uint8_t IndexedCanvas::indexFor(uint16_t color) {
+  for (uint16_t i = 0; i < used_; ++i) {
+    if (keys_[i] == color) return static_cast<uint8_t>(i);
+  }
+  if (used_ < (1u << bits_)) {
+    keys_[used_] = color;
+    shown_[used_] = toWireOrder(color);
+    return static_cast<uint8_t>(used_++);
+  }
+  // Palette is full: draw with the closest existing entry.
+  uint8_t best = 0;
+  int32_t bestDistance = INT32_MAX;
+  for (uint16_t i = 0; i < used_; ++i) {
+    const int32_t distance = colorDistance(keys_[i], color);
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = static_cast<uint8_t>(i);
+    }
+  }
+  return best;
+}
+
+uint8_t IndexedCanvas::indexAt(int16_t x, int16_t y) const {
+  const uint8_t *row = pixels_ + y * pitch_;
+  if (bits_ == 8) return row[x];
+  return (x & 1) ? row[x / 2] >> 4 : row[x / 2] & 0x0F;
+}
+
+void IndexedCanvas::readRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest) {
+  const IndexedCanvas &canvas = *static_cast<const IndexedCanvas *>(context);
+  if (!canvas.pixels_) {
+    pixels::fill(dest, canvas.keys_[0], x1 - x0 + 1);
+    return;
+  }
+  for (int16_t x = x0; x <= x1; ++x) {
+    int16_t px = x, py = y;
+    rotatePoint(px, py, canvas.panelTurns_, kSize);
+    *dest++ = canvas.keys_[canvas.indexAt(px, py)];
+  }
+}
+
+void IndexedCanvas::drawRows(int16_t x, int16_t y, int16_t w, int16_t h, RowSource source, void *context) {
+  if (!source || w <= 0 || h <= 0) return;
+  int16_t x0 = std::max<int16_t>(x, 0);
+  int16_t y0 = std::max<int16_t>(y, 0);
+  int16_t x1 = std::min<int16_t>(x + w - 1, kSize - 1);
+  int16_t y1 = std::min<int16_t>(y + h - 1, kSize - 1);
+  if (x0 > x1 || y0 > y1 || !clips_.clip(x0, y0, x1, y1, panelTurns_)) return;
+
+  // Runs of one color share a palette lookup and a span fill.
+  uint16_t row[kSize];
+  for (int16_t ly = y0; ly <= y1; ++ly) {
+    source(context, ly, x0, x1, row);
+    int16_t start = x0;
+    for (int16_t lx = x0 + 1; lx <= x1 + 1; ++lx) {
+      if (lx <= x1 && row[lx - x0] == row[start - x0]) continue;
+      fillLogicalRect(start, ly, lx - 1, ly, indexFor(row[start - x0]));
+      start = lx;
+    }
+  }
+}
+
+void IndexedCanvas::pushClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  clips_.push(x0, y0, x1, y1, panelTurns_);
+}
+
+void IndexedCanvas::popClip() {
+  clips_.pop();
+}
+
+void IndexedCanvas::setRotation(uint8_t rotation) {
+  rotation_ = rotation % 4;
+  panelTurns_ = static_cast<uint8_t>((rotation_ + 4 - Gc9a01Graphics::kPanelRotation) % 4);
+}
+
+void IndexedCanvas::drawTextBox(int16_t x, int16_t y, int16_t w, int16_t h,
+                                int16_t textX, int16_t textY,
+                                const char *text,
+                                uint16_t colorText, uint16_t colorBG,
+                                uint8_t textSize) {
+  if (!text || w <= 0 || h <= 0) return;
+  int16_t x0 = std::max<int16_t>(x, 0);
+  int16_t y0 = std::max<int16_t>(y, 0);
+  int16_t x1 = std::min<int16_t>(x + w - 1, kSize - 1);
+  int16_t y1 = std::min<int16_t>(y + h - 1, kSize - 1);
+  if (x0 > x1 || y0 > y1 || !clips_.clip(x0, y0, x1, y1, panelTurns_)) return;
+
+  // Index writes are cheap, so the background goes down first and the ink
+  // runs of each row are painted over it.
+  const uint8_t bg = indexFor(colorBG);
+  const uint8_t fg = indexFor(colorText);
+  const size_t length = std::strcspn(text, "\n");
+  const int scale = font5x7::scaleFor(textSize);
+  fillLogicalRect(x0, y0, x1, y1, bg);
+  for (int16_t row = y0; row <= y1; ++row) {
+    font5x7::inkRuns(text, length, textX, textY, scale, x0, x1, row, [&](int a, int b) {
+      fillLogicalRect(static_cast<int16_t>(a), row, static_cast<int16_t>(b), row, fg);
+    });
+  }
+}
+
+void IndexedCanvas::fillLogicalRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t index) {
+  if (!pixels_) return;
+  if (x0 > x1) std::swap(x0, x1);
+  if (y0 > y1) std::swap(y0, y1);
+  if (x1 < 0 || y1 < 0 || x0 >= kSize || y0 >= kSize) return;
+  x0 = std::max<int16_t>(x0, 0);
+  y0 = std::max<int16_t>(y0, 0);
+  x1 = std::min<int16_t>(x1, kSize - 1);
+  y1 = std::min<int16_t>(y1, kSize - 1);
+  rotateRect(x0, y0, x1, y1, panelTurns_, kSize);
+  if (!clips_.clip(x0, y0, x1, y1)) return;
+  fillPanelRect(x0, y0, x1, y1, index);
+}
+
+void IndexedCanvas::fillPanelRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t index) {
+  for (int16_t y = y0; y <= y1; ++y) {
+    uint8_t *row = pixels_ + y * pitch_;
+    if (bits_ == 8) {
+      std::memset(row + x0, index, x1 - x0 + 1);
+    } else {
+      // Two pixels per byte, the even column in the low nibble.
+      int16_t a = x0;
+      int16_t b = x1;
+      if (a & 1) {
+        row[a / 2] = static_cast<uint8_t>((row[a / 2] & 0x0F) | (index << 4));
+        ++a;
+      }
+      if (a <= b && !(b & 1)) {
+        row[b / 2] = static_cast<uint8_t>((row[b / 2] & 0xF0) | index);
+        --b;
+      }
+      if (a < b) {
+        std::memset(row + a / 2, index * 0x11, (b - a + 1) / 2);
+      }
+    }
+    dirtyMin_[y] = static_cast<uint8_t>(std::min<int16_t>(dirtyMin_[y], x0));
+    dirtyMax_[y] = static_cast<uint8_t>(std::max<int16_t>(dirtyMax_[y], x1));
+  }
+}
+
+void IndexedCanvas::expandRow(void *context, int16_t y, int16_t x0, int16_t x1, uint16_t *dest) {
+  const IndexedCanvas &canvas = *static_cast<const IndexedCanvas *>(context);
+  const uint8_t *row = canvas.pixels_ + y * canvas.pitch_;
+  if (canvas.bits_ == 8) {
+    pixels::expand8(dest, row + x0, x1 - x0 + 1, canvas.shown_);
+  } else {
+    pixels::expand4(dest, row, x0, x1 - x0 + 1, canvas.shown_);
+  }
+}
+
+void IndexedCanvas::flush() {
+  if (!pixels_ || !panel_) return;
+
+  // Consecutive dirty rows are sent as one rect while its bounding box
+  // wastes little; clean rows always end a rect.
+  int16_t top = -1;
+  int16_t left = 0;
+  int16_t right = 0;
+  int32_t waste = 0;
+  auto send = [&](int16_t bottom) {
+    if (top >= 0) {
+      panel_->pushRows(left, top, right, bottom, expandRow, this);
+    }
+    top = -1;
+  };
+  for (int16_t y = 0; y < kSize; ++y) {
+    if (dirtyMin_[y] > dirtyMax_[y]) {
+      send(y - 1);
+      continue;
+    }
+    const int16_t a = dirtyMin_[y];
+    const int16_t b = dirtyMax_[y];
+    dirtyMin_[y] = 0xFF;
+    dirtyMax_[y] = 0;
+    if (top >= 0) {
+      const int16_t newLeft = std::min(left, a);
+      const int16_t newRight = std::max(right, b);
+      const int32_t grown = static_cast<int32_t>((left - newLeft) + (newRight - right)) * (y - top);
+      const int32_t newWaste = waste + grown + (newRight - newLeft) - (b - a);
+      if (newWaste <= kFlushSlackPixels) {
+        left = newLeft;
+        right = newRight;
+        waste = newWaste;
+        continue;
+      }
+      send(y - 1);
+    }
+    top = y;
+    left = a;
+    right = b;
+    waste = 0;
+  }
+  send(kSize - 1);
+}
+
+void IndexedCanvas::displayOn() {
+  if (panel_) panel_->displayOn();
+}
+
+void IndexedCanvas::displayOff() {
+  if (panel_) panel_->displayOff();
+}
+
+}  // namespace graphics
@@ -3,9 +3,18 @@
 #include <cstdio>
 #include <cstring>
 
-#include "watchface.h"
-#include "graphics_utils.h"
+#include "aa_text.h"
 #include "esp_system.h"
+#include "font_lato24.h"
+#include "gc9a01_graphics.h"
+#include "graphics_utils.h"
+#include "indexed_canvas.h"
+#include "recording_graphics.h"
+#include "watchface.h"
+
+#ifndef HACKTOR_AA_TEXT
+#define HACKTOR_AA_TEXT 1
+#endif
 
 namespace info_screen {
 
@@ -58,7 +67,8 @@ void formatBleSync(const system_stats::Stats &stats, char *buffer, size_t len) {
 
 }  // namespace
 
-void draw(graphics::Graphics &display, const system_stats::Stats &stats, const tm &currentTime, uint8_t batteryPercent, float batteryVoltage) {
+template <typename Display>
+void draw(Display &display, const system_stats::Stats &stats, const tm &currentTime, uint8_t batteryPercent, float batteryVoltage) {
   graphics::RotationScopeCW rotation(display);
 
   display.fillScreen(COLOR_BG);
@@ -112,7 +122,26 @@ void draw(graphics::Graphics &display, const system_stats::Stats &stats, const t
   formatTime(currentTime, clockLine, sizeof(clockLine));
   formatDate(currentTime, dateLine, sizeof(dateLine));
   printCentered(1, "Now:", 4);
+#if HACKTOR_AA_TEXT
+  {
+    // drawRows reads the run when the rows go out, possibly after draw()
+    // has returned, so it is not kept on the stack.
+    static char clockText[sizeof(clockLine)];
+    static graphics::AaTextRun clock;
+    const graphics::AaFont &font = graphics::fonts::kLato24;
+    std::snprintf(clockText, sizeof(clockText), "%s", clockLine);
+    clock.font = &font;
+    clock.text = clockText;
+    clock.setColors(COLOR_TEXT, COLOR_BG);
+    const int16_t w = graphics::aaTextWidth(font, clockText);
+    clock.x = static_cast<int16_t>((display.width() - w) / 2);
+    clock.y = static_cast<int16_t>(cursorY);
+    graphics::drawAaTextBox(display, clock.x, clock.y, w, font.height, clock);
+    cursorY += font.height + 4;
+  }
+#else
   printCentered(1, clockLine, 4);
+#endif
   printCentered(1, dateLine, 6);
 
   std::snprintf(line, sizeof(line), "Reset reason: %s", resetReasonToString(stats.lastResetReason));
@@ -128,4 +157,9 @@ void draw(graphics::Graphics &display, const system_stats::Stats &stats, const t
 
 }
 
+template void draw(graphics::Graphics &, const system_stats::Stats &, const tm &, uint8_t, float);
+template void draw(graphics::Gc9a01Graphics &, const system_stats::Stats &, const tm &, uint8_t, float);
+template void draw(graphics::RecordingGraphics &, const system_stats::Stats &, const tm &, uint8_t, float);
+template void draw(graphics::IndexedCanvas &, const system_stats::Stats &, const tm &, uint8_t, float);
+
 }  // namespace info_screen
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include <Wire.h>
+#include <algorithm>
 #include "graphics.h"
 #include <math.h>
 #include <time.h>
@@ -18,12 +19,42 @@
 #include "ble_time_sync.h"
 #include "system_stats.h"
 #include "info_screen.h"
+#include "image_pack.h"
+#include "render_bench.h"
+#include "render_task.h"
+
+#ifndef HACKTOR_RENDER_BENCH
+#define HACKTOR_RENDER_BENCH 0
+#endif
 
 /* -------- Backlight PWM ramp (non-blocking) -------- */
 
 /* ISRs */
 void IRAM_ATTR imuInt1ISR() { steps::flagInterrupt(); }
 void IRAM_ATTR imuInt2ISR() { power_manager::flagTiltInterrupt(); }
+
+namespace {
+using FrameKind = render_task::FrameRequest::Kind;
+
+// Snapshot of what a frame of `kind` shows, taken on the loop's side.
+render_task::FrameRequest frameRequest(FrameKind kind) {
+  auto &state = app_state::get();
+  render_task::FrameRequest request;
+  request.kind = kind;
+  request.time = state.display.currentTime;
+  request.steps = steps::today();
+  request.batteryPercent = state.battery.percent;
+  request.batteryVoltage = state.battery.voltage;
+  if (kind == FrameKind::Info) {
+    request.stats = system_stats::current();
+  }
+  return request;
+}
+
+void redrawWatchface() {
+  render_task::submit(frameRequest(FrameKind::WatchfaceFull));
+}
+}  // namespace
 //bla
 /* ---------------- Setup ---------------- */
 void setup() {
@@ -38,6 +69,8 @@ void setup() {
   Serial.begin(115200);
   system_stats::init();
 
+  // Hand images are looked up by watchface::init().
+  image_pack::begin();
   watchface::init();
   display_manager::init();
   
@@ -52,7 +85,11 @@ void setup() {
   delay(150);
 
   display_manager::begin();
+#if HACKTOR_RENDER_BENCH
+  render_bench::run(display_manager::panel());
+#endif
   display_manager::get().fillScreen(watchface::COLOR_BG);
+  display_manager::get().flush();
   time_keeper::initializeFromCompileTime();
   ble_time_sync::init();
   ble_time_sync::requestImmediateSync();
@@ -79,17 +116,8 @@ void setup() {
     steps::init(s16);
   }
 
-  auto &display = display_manager::get();
-  watchface::drawFullFaceAndHands(
-    display,
-    displayState.currentTime,
-    steps::today(),
-    batteryState.percent,
-    displayState.prevHourX, displayState.prevHourY,
-    displayState.prevMinuteX, displayState.prevMinuteY,
-    displayState.prevSecondX, displayState.prevSecondY,
-    displayState.prevSecondTailX, displayState.prevSecondTailY
-  );
+  redrawWatchface();
+  render_task::waitIdle();
 
   displayState.lastTickMs     = millis();
   displayState.rtcBaseMs      = displayState.lastTickMs;
@@ -101,16 +129,23 @@ void setup() {
   powerState.displayOn     = true;
   powerState.displayExpireMs = millis() + power_manager::DISPLAY_ON_TIMEOUT_MS;
   Wire.setClock(400000);
+
+  // From here on frames are drawn on the other core, if there is one.
+  const bool renderTask = render_task::start();
+  LOG_PRINTF(1, "Render task: %s\n", renderTask ? "OK" : "off, drawing in loop");
 }
 
 /* ---------------- Loop ---------------- */
 namespace {
+// Set by a pass that slept, which is left out of the latency figures.
+bool sleptThisPass = false;
+
 void processSteps() {
   steps::serviceInterrupt();
   steps::pollWatchdog(millis());
 }
 
-void handleInfoButton(graphics::Graphics &display) {
+void handleInfoButton() {
   static bool lastRawState = false;
   static bool debouncedState = false;
   static unsigned long lastChangeMs = 0;
@@ -133,7 +168,6 @@ void handleInfoButton(graphics::Graphics &display) {
       auto &runtime = app_state::get();
       auto &displayState = runtime.display;
       auto &powerState = runtime.power;
-      auto &batteryState = runtime.battery;
 
       powerState.displayOn = true;
       powerState.displayExpireMs = now + power_manager::DISPLAY_ON_TIMEOUT_MS;
@@ -147,16 +181,7 @@ void handleInfoButton(graphics::Graphics &display) {
         displayState.rtcBaseMs = now;
       } else {
         displayState.activeScreen = app_state::DisplayState::Screen::Watchface;
-        watchface::drawFullFaceAndHands(
-          display,
-          displayState.currentTime,
-          steps::today(),
-          batteryState.percent,
-          displayState.prevHourX, displayState.prevHourY,
-          displayState.prevMinuteX, displayState.prevMinuteY,
-          displayState.prevSecondX, displayState.prevSecondY,
-          displayState.prevSecondTailX, displayState.prevSecondTailY
-        );
+        redrawWatchface();
         displayState.lastTickMs = now;
         displayState.rtcBaseMs = now;
         displayState.infoNeedsRedraw = false;
@@ -177,11 +202,10 @@ void handleDisplayTimeout() {
   }
 }
 
-void refreshDisplayIfNeeded(graphics::Graphics &display) {
+void refreshDisplayIfNeeded() {
   auto &state = app_state::get();
   auto &displayState = state.display;
   auto &powerState = state.power;
-  auto &batteryState = state.battery;
 
   if (!powerState.displayOn) {
     return;
@@ -205,49 +229,7 @@ void refreshDisplayIfNeeded(graphics::Graphics &display) {
 
   time_keeper::applyElapsedWalltime();
 
-  int nhx, nhy, nmx, nmy, nsx, nsy, ntx, nty;
-  watchface::calcHourEnd(displayState.currentTime, nhx, nhy);
-  watchface::calcMinuteEnd(displayState.currentTime, nmx, nmy);
-  watchface::calcSecondEnds(displayState.currentTime, nsx, nsy, ntx, nty);
-
-  bool needHour   = (nhx != displayState.prevHourX) || (nhy != displayState.prevHourY);
-  bool needMinute = (nmx != displayState.prevMinuteX) || (nmy != displayState.prevMinuteY);
-
-  display.drawLine(watchface::CENTER_X, watchface::CENTER_Y, displayState.prevSecondX, displayState.prevSecondY, watchface::COLOR_BG);
-  display.drawLine(watchface::CENTER_X, watchface::CENTER_Y, displayState.prevSecondTailX, displayState.prevSecondTailY, watchface::COLOR_BG);
-  display.fillCircle(watchface::CENTER_X, watchface::CENTER_Y, 6, watchface::COLOR_BG);
-
-  watchface::drawDateRotatedCWRightOfCenter(display, displayState.currentTime);
-  watchface::drawStepsBelowCenter(display, steps::today());
-  watchface::drawBatteryRotatedCWLeftOfCenter(display, batteryState.percent);
-  watchface::drawTicks(display);
-
-  if (needHour) {
-    watchface::drawThick3Line(display, watchface::CENTER_X, watchface::CENTER_Y, displayState.prevHourX, displayState.prevHourY, watchface::COLOR_BG);
-    watchface::drawThick3Line(display, watchface::CENTER_X, watchface::CENTER_Y, nhx, nhy, watchface::COLOR_HOUR_HAND);
-    displayState.prevHourX = nhx;
-    displayState.prevHourY = nhy;
-  } else {
-    watchface::drawThick3Line(display, watchface::CENTER_X, watchface::CENTER_Y, displayState.prevHourX, displayState.prevHourY, watchface::COLOR_HOUR_HAND);
-  }
-
-  if (needMinute) {
-    watchface::drawThick3Line(display, watchface::CENTER_X, watchface::CENTER_Y, displayState.prevMinuteX, displayState.prevMinuteY, watchface::COLOR_BG);
-    watchface::drawThick3Line(display, watchface::CENTER_X, watchface::CENTER_Y, nmx, nmy, watchface::COLOR_MIN_HAND);
-    displayState.prevMinuteX = nmx;
-    displayState.prevMinuteY = nmy;
-  } else {
-    watchface::drawThick3Line(display, watchface::CENTER_X, watchface::CENTER_Y, displayState.prevMinuteX, displayState.prevMinuteY, watchface::COLOR_MIN_HAND);
-  }
-
-  display.drawLine(watchface::CENTER_X, watchface::CENTER_Y, nsx, nsy, watchface::COLOR_SEC_HAND);
-  display.drawLine(watchface::CENTER_X, watchface::CENTER_Y, ntx, nty, watchface::COLOR_SEC_HAND);
-  display.fillCircle(watchface::CENTER_X, watchface::CENTER_Y, 6, watchface::COLOR_FACE);
-  display.fillCircle(watchface::CENTER_X, watchface::CENTER_Y, 3, watchface::COLOR_SEC_HAND);
-  displayState.prevSecondX = nsx;
-  displayState.prevSecondY = nsy;
-  displayState.prevSecondTailX = ntx;
-  displayState.prevSecondTailY = nty;
+  render_task::submit(frameRequest(FrameKind::WatchfaceTick));
 
   displayState.lastTickMs += elapsed_s * 1000UL;
 }
@@ -256,9 +238,9 @@ void handlePendingSleep(graphics::Graphics &display) {
   auto &state = app_state::get();
   auto &displayState = state.display;
   auto &powerState = state.power;
-  auto &batteryState = state.battery;
 
   if (powerState.pendingPanelOff && backlight::isIdle()) {
+    render_task::waitIdle();
     display.displayOff();
     powerState.pendingPanelOff = false;
   }
@@ -267,24 +249,17 @@ void handlePendingSleep(graphics::Graphics &display) {
     return;
   }
 
+  render_task::waitIdle();
   powerState.displayOn = false;
   power_manager::sleepUntilTilt();
+  sleptThisPass = true;
   power_manager::panelSleep(false);
   system_stats::recordScreenOnEvent();
   imu::setAccelODR(0x40);
 
   time_keeper::applyElapsedWalltime();
   if (displayState.activeScreen == app_state::DisplayState::Screen::Watchface) {
-    watchface::drawFullFaceAndHands(
-      display,
-      displayState.currentTime,
-      steps::today(),
-      batteryState.percent,
-      displayState.prevHourX, displayState.prevHourY,
-      displayState.prevMinuteX, displayState.prevMinuteY,
-      displayState.prevSecondX, displayState.prevSecondY,
-      displayState.prevSecondTailX, displayState.prevSecondTailY
-    );
+    redrawWatchface();
   } else {
     displayState.infoNeedsRedraw = true;
     displayState.infoShownVersion = 0;
@@ -298,7 +273,7 @@ void handlePendingSleep(graphics::Graphics &display) {
   powerState.pendingSleep     = false;
 }
 
-void renderInfoScreenIfNeeded(graphics::Graphics &display) {
+void renderInfoScreenIfNeeded() {
   auto &state = app_state::get();
   auto &displayState = state.display;
   if (displayState.activeScreen != app_state::DisplayState::Screen::Info) {
@@ -311,26 +286,56 @@ void renderInfoScreenIfNeeded(graphics::Graphics &display) {
     return;
   }
 
-  auto &batteryState = state.battery;
-  info_screen::draw(display, system_stats::current(), displayState.currentTime, batteryState.percent, batteryState.voltage);
+  render_task::submit(frameRequest(FrameKind::Info));
   displayState.infoShownVersion = system_stats::version();
   displayState.infoLastDrawnSecond = displayState.currentTime.tm_sec;
   displayState.infoNeedsRedraw = false;
 }
+#if HACKTOR_DEBUG_LEVEL >= 1
+// The longest pass is how long a button press or tilt can go unserviced;
+// it is logged and reset every few seconds.
+void recordLoopLatency(uint32_t passUs) {
+  constexpr uint32_t kWindowMs = 10000;
+  static uint32_t worstUs = 0;
+  static uint32_t passes = 0;
+  static uint32_t windowStartMs = millis();
+  worstUs = std::max(worstUs, passUs);
+  ++passes;
+  if (millis() - windowStartMs < kWindowMs) return;
+  LOG_PRINTF(1, "[loop] worst pass %lu us of %lu in %lu ms\n",
+             static_cast<unsigned long>(worstUs),
+             static_cast<unsigned long>(passes),
+             static_cast<unsigned long>(millis() - windowStartMs));
+  worstUs = 0;
+  passes = 0;
+  windowStartMs = millis();
+}
+#endif
 }  // namespace
 
 void loop() {
   auto &display = display_manager::get();
+#if HACKTOR_DEBUG_LEVEL >= 1
+  const uint32_t loopStartUs = micros();
+#endif
+  sleptThisPass = false;
 
   ble_time_sync::service();
-  handleInfoButton(display);
+  handleInfoButton();
 
   backlight::update();
   power_manager::serviceTiltIRQ();
   processSteps();
   battery_monitor::poll();
   handleDisplayTimeout();
-  refreshDisplayIfNeeded(display);
-  renderInfoScreenIfNeeded(display);
+  refreshDisplayIfNeeded();
+  renderInfoScreenIfNeeded();
   handlePendingSleep(display);
+  // Without the render task, frames are drawn here a slice per pass.
+  render_task::service();
+#if HACKTOR_DEBUG_LEVEL >= 1
+  if (!sleptThisPass) {
+    recordLoopLatency(micros() - loopStartUs);
+  }
+#endif
 }
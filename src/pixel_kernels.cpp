@@ -0,0 +1,288 @@
+#include "pixel_kernels.h"
+
+#include <cstring>
+
+#if defined(__XTENSA__)
+#include "sdkconfig.h"
+#endif
+
+// The PIE paths have not been assembled or run on an ESP32-S3 yet, so they
+// stay off until render_bench shows them matching the portable kernels.
+#ifndef HACKTOR_PIE_KERNELS
+#define HACKTOR_PIE_KERNELS 0
+#endif
+
+#if HACKTOR_PIE_KERNELS && defined(__XTENSA__) && defined(CONFIG_IDF_TARGET_ESP32S3)
+#define PIXEL_KERNELS_PIE 1
+#else
+#define PIXEL_KERNELS_PIE 0
+#endif
+
+namespace graphics {
+namespace pixels {
+namespace {
+
+// Two pixels per 32-bit access where both pointers allow it; the core
+// faults on unaligned word loads. memcpy keeps the compiler honest about
+// aliasing and still compiles to one load or store.
+inline uint32_t load32(const uint16_t *p) {
+  uint32_t word;
+  std::memcpy(&word, __builtin_assume_aligned(p, 4), sizeof(word));
+  return word;
+}
+
+inline void store32(uint16_t *p, uint32_t word) {
+  std::memcpy(__builtin_assume_aligned(p, 4), &word, sizeof(word));
+}
+
+inline bool wordAligned(const void *p) {
+  return (reinterpret_cast<uintptr_t>(p) & 3) == 0;
+}
+
+inline uint16_t swap16(uint16_t value) {
+  return static_cast<uint16_t>((value >> 8) | (value << 8));
+}
+
+// Same as Gc9a01Graphics' conversion: RGB565 to R4G4B4 by dropping the low
+// bits of each channel.
+inline uint16_t toRgb444(uint16_t color) {
+  return static_cast<uint16_t>(((color >> 4) & 0x0F00) | ((color >> 3) & 0x00F0) | ((color >> 1) & 0x000F));
+}
+
+// RGB565 with its channels spread over a word, green in the high half, so
+// one multiply scales all three with room for the carries.
+constexpr uint32_t kSpreadMask = 0x07E0F81F;
+
+inline uint32_t spread(uint16_t color) {
+  return (color | (static_cast<uint32_t>(color) << 16)) & kSpreadMask;
+}
+
+inline uint16_t blend565(uint16_t src, uint16_t dest, uint32_t alpha) {
+  const uint32_t back = spread(dest);
+  const uint32_t mixed = ((((spread(src) - back) * alpha) >> 5) + back) & kSpreadMask;
+  return static_cast<uint16_t>(mixed | (mixed >> 16));
+}
+
+#if PIXEL_KERNELS_PIE
+// Eight pixels per store from a q register holding `value` in every lane.
+// dest must be 16-byte aligned. The q registers are only touched here, so
+// nothing else has state in them to lose.
+void fillBlocks(uint16_t *dest, uint16_t value, size_t blocks) {
+  asm volatile(
+      "ee.vldbc.16 q0, %[value]\n"
+      "1:\n"
+      "ee.vst.128.ip q0, %[dest], 16\n"
+      "addi %[blocks], %[blocks], -1\n"
+      "bnez %[blocks], 1b\n"
+      : [dest] "+r"(dest), [blocks] "+r"(blocks)
+      : [value] "r"(&value)
+      : "memory");
+}
+
+// Swaps the bytes of eight pixels per load and store, the same shifts and
+// masks portable::swapBytes does on a word. Both pointers must be 16-byte
+// aligned; they may be equal.
+void swapBlocks(uint16_t *dest, const uint16_t *src, size_t blocks) {
+  static const uint32_t kLowBytes = 0x00FF00FF;
+  static const uint32_t kHighBytes = 0xFF00FF00;
+  asm volatile(
+      "ee.vldbc.32 q2, %[low]\n"
+      "ee.vldbc.32 q3, %[high]\n"
+      "ssai 8\n"
+      "1:\n"
+      "ee.vld.128.ip q0, %[src], 16\n"
+      "ee.vsr.32 q1, q0\n"
+      "ee.vsl.32 q0, q0\n"
+      "ee.andq q1, q1, q2\n"
+      "ee.andq q0, q0, q3\n"
+      "ee.orq q0, q0, q1\n"
+      "ee.vst.128.ip q0, %[dest], 16\n"
+      "addi %[blocks], %[blocks], -1\n"
+      "bnez %[blocks], 1b\n"
+      : [dest] "+r"(dest), [src] "+r"(src), [blocks] "+r"(blocks)
+      : [low] "r"(&kLowBytes), [high] "r"(&kHighBytes)
+      : "sar", "memory");
+}
+#endif
+
+}  // namespace
+
+namespace portable {
+
+void fill(uint16_t *dest, uint16_t value, size_t count) {
+  if (count > 0 && !wordAligned(dest)) {
+    *dest++ = value;
+    --count;
+  }
+  const uint32_t pair = value | (static_cast<uint32_t>(value) << 16);
+  for (; count >= 2; count -= 2, dest += 2) {
+    store32(dest, pair);
+  }
+  if (count) *dest = value;
+}
+
+void swapBytes(uint16_t *dest, const uint16_t *src, size_t count) {
+  if (wordAligned(dest) != wordAligned(src)) {
+    for (size_t i = 0; i < count; ++i) {
+      dest[i] = swap16(src[i]);
+    }
+    return;
+  }
+  if (count > 0 && !wordAligned(dest)) {
+    *dest++ = swap16(*src++);
+    --count;
+  }
+  for (; count >= 2; count -= 2, dest += 2, src += 2) {
+    const uint32_t word = load32(src);
+    store32(dest, ((word >> 8) & 0x00FF00FF) | ((word << 8) & 0xFF00FF00));
+  }
+  if (count) *dest = swap16(*src);
+}
+
+void expand8(uint16_t *dest, const uint8_t *indices, size_t count, const uint16_t *lut) {
+  if (count > 0 && !wordAligned(dest)) {
+    *dest++ = lut[*indices++];
+    --count;
+  }
+  for (; count >= 2; count -= 2, dest += 2, indices += 2) {
+    store32(dest, lut[indices[0]] | (static_cast<uint32_t>(lut[indices[1]]) << 16));
+  }
+  if (count) *dest = lut[*indices];
+}
+
+void expand4(uint16_t *dest, const uint8_t *indices, size_t first, size_t count, const uint16_t *lut) {
+  indices += first / 2;
+  if (count > 0 && (first & 1)) {
+    *dest++ = lut[*indices++ >> 4];
+    --count;
+  }
+  if (wordAligned(dest)) {
+    // A byte holds exactly the two pixels of one word.
+    for (; count >= 2; count -= 2, dest += 2, ++indices) {
+      const uint8_t pair = *indices;
+      store32(dest, lut[pair & 0x0F] | (static_cast<uint32_t>(lut[pair >> 4]) << 16));
+    }
+  } else {
+    for (; count >= 2; count -= 2, dest += 2, ++indices) {
+      const uint8_t pair = *indices;
+      dest[0] = lut[pair & 0x0F];
+      dest[1] = lut[pair >> 4];
+    }
+  }
+  if (count) *dest = lut[*indices & 0x0F];
+}
+
+void expand1(uint16_t *dest, const uint8_t *bits, size_t first, size_t count, uint16_t fg, uint16_t bg) {
+  bits += first / 8;
+  unsigned bit = first % 8;
+  auto next = [&]() {
+    const uint16_t color = (*bits >> bit) & 1 ? fg : bg;
+    if (++bit == 8) {
+      bit = 0;
+      ++bits;
+    }
+    return color;
+  };
+  if (count > 0 && !wordAligned(dest)) {
+    *dest++ = next();
+    --count;
+  }
+  if (count >= 2 && (bit & 1) == 0) {
+    // Two bits pick one of four words.
+    const uint32_t pairs[4] = {
+      bg | (static_cast<uint32_t>(bg) << 16),
+      fg | (static_cast<uint32_t>(bg) << 16),
+      bg | (static_cast<uint32_t>(fg) << 16),
+      fg | (static_cast<uint32_t>(fg) << 16),
+    };
+    for (; count >= 2; count -= 2, dest += 2) {
+      store32(dest, pairs[(*bits >> bit) & 3]);
+      bit += 2;
+      if (bit == 8) {
+        bit = 0;
+        ++bits;
+      }
+    }
+  }
+  for (; count > 0; --count) {
+    *dest++ = next();
+  }
+}
+
+void blend(uint16_t *dest, const uint16_t *src, uint8_t alpha, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = blend565(src[i], dest[i], alpha);
+  }
+}
+
+size_t packRgb444(uint8_t *dest, const uint16_t *src, size_t pairs) {
+  for (size_t i = 0; i < pairs; ++i) {
+    const uint16_t a = toRgb444(swap16(src[2 * i]));
+    const uint16_t b = toRgb444(swap16(src[2 * i + 1]));
+    dest[3 * i] = static_cast<uint8_t>(a >> 4);
+    dest[3 * i + 1] = static_cast<uint8_t>(((a & 0x0F) << 4) | (b >> 8));
+    dest[3 * i + 2] = static_cast<uint8_t>(b & 0xFF);
+  }
+  return pairs * 3;
+}
+
+}  // namespace portable
+
+void fill(uint16_t *dest, uint16_t value, size_t count) {
+#if PIXEL_KERNELS_PIE
+  // Below a few blocks the alignment head and tail cost more than the
+  // vector stores save.
+  if (count >= 32) {
+    const size_t head = ((16 - (reinterpret_cast<uintptr_t>(dest) & 15)) & 15) / 2;
+    portable::fill(dest, value, head);
+    dest += head;
+    count -= head;
+    fillBlocks(dest, value, count / 8);
+    dest += count & ~static_cast<size_t>(7);
+    count &= 7;
+  }
+#endif
+  portable::fill(dest, value, count);
+}
+
+void swapBytes(uint16_t *dest, const uint16_t *src, size_t count) {
+#if PIXEL_KERNELS_PIE
+  // Vector loads and stores only line up when both pointers share their
+  // offset within 16 bytes, as row buffers from the same allocator do.
+  if (count >= 32 && ((reinterpret_cast<uintptr_t>(dest) ^ reinterpret_cast<uintptr_t>(src)) & 15) == 0) {
+    const size_t head = ((16 - (reinterpret_cast<uintptr_t>(dest) & 15)) & 15) / 2;
+    portable::swapBytes(dest, src, head);
+    dest += head;
+    src += head;
+    count -= head;
+    swapBlocks(dest, src, count / 8);
+    dest += count & ~static_cast<size_t>(7);
+    src += count & ~static_cast<size_t>(7);
+    count &= 7;
+  }
+#endif
+  portable::swapBytes(dest, src, count);
+}
+
+void expand8(uint16_t *dest, const uint8_t *indices, size_t count, const uint16_t *lut) {
+  portable::expand8(dest, indices, count, lut);
+}
+
+void expand4(uint16_t *dest, const uint8_t *indices, size_t first, size_t count, const uint16_t *lut) {
+  portable::expand4(dest, indices, first, count, lut);
+}
+
+void expand1(uint16_t *dest, const uint8_t *bits, size_t first, size_t count, uint16_t fg, uint16_t bg) {
+  portable::expand1(dest, bits, first, count, fg, bg);
+}
+
+void blend(uint16_t *dest, const uint16_t *src, uint8_t alpha, size_t count) {
+  portable::blend(dest, src, alpha, count);
+}
+
+size_t packRgb444(uint8_t *dest, const uint16_t *src, size_t pairs) {
+  return portable::packRgb444(dest, src, pairs);
+}
+
+}  // namespace pixels
+}  // namespace graphics
@@ -0,0 +1,273 @@
+#include "recording_graphics.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "esp_heap_caps.h"
+#include "gc9a01_graphics.h"
+#include "graphics_utils.h"
+
+namespace graphics {
+
+// The panel's rotation, not the target's current one: display_manager
+// creates the recorder before begin() has set up the panel.
+RecordingGraphics::RecordingGraphics(Graphics &target)
+    : target_(target), rotation_(Gc9a01Graphics::kPanelRotation) {}
+
+RecordingGraphics::~RecordingGraphics() {
+  heap_caps_free(fills_);
+}
+
+bool RecordingGraphics::begin(size_t capacity) {
+  if (fills_) return true;
+  // Indices are 16 bits wide.
+  capacity = std::min<size_t>(capacity, UINT16_MAX);
+  const size_t bytes = capacity * (sizeof(Fill) + 2 * sizeof(uint16_t));
+  void *arena = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!arena) return false;
+  fills_ = static_cast<Fill *>(arena);
+  order_ = reinterpret_cast<uint16_t *>(fills_ + capacity);
+  active_ = order_ + capacity;
+  capacity_ = capacity;
+  count_ = 0;
+  return true;
+}
+
+void RecordingGraphics::record(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint8_t text) {
+  if (x0 > x1) std::swap(x0, x1);
+  if (y0 > y1) std::swap(y0, y1);
+  if (x1 < 0 || y1 < 0 || x0 >= kSize || y0 >= kSize) return;
+  x0 = std::max<int16_t>(x0, 0);
+  y0 = std::max<int16_t>(y0, 0);
+  x1 = std::min<int16_t>(x1, kSize - 1);
+  y1 = std::min<int16_t>(y1, kSize - 1);
+  // Everything is kept upright so fills from differently rotated commands
+  // can occlude and merge with each other.
+  rotateRect(x0, y0, x1, y1, rotation_, kSize);
+  if (!clips_.clip(x0, y0, x1, y1)) return;
+
+  if (!fills_) {
+    const uint8_t previous = target_.getRotation();
+    target_.setRotation(0);
+    target_.fillRect(x0, y0, x1 - x0 + 1, y1 - y0 + 1, color);
+    target_.setRotation(previous);
+    return;
+  }
+  if (count_ == capacity_) {
+    endFrame();
+  }
+  fills_[count_++] = Fill{static_cast<uint8_t>(x0), static_cast<uint8_t>(y0),
+                          static_cast<uint8_t>(x1), static_cast<uint8_t>(y1), color, text};
+}
+
+void RecordingGraphics::emit(const Run &run, int16_t y1) {
+  int16_t x0 = run.x0;
+  int16_t y0 = run.y0;
+  int16_t x1 = run.x1;
+  if (!run.text) {
+    target_.fillRect(x0, y0, x1 - x0 + 1, y1 - y0 + 1, run.color);
+    return;
+  }
+  if (run.text > kMaxTexts) {
+    // Only the uncovered part of the rows is read and sent.
+    const Rows &rows = rows_[run.text - kMaxTexts - 1];
+    rotateRect(x0, y0, x1, y1, static_cast<uint8_t>((4 - rows.rotation) % 4), kSize);
+    target_.setRotation(rows.rotation);
+    target_.drawRows(x0, y0, x1 - x0 + 1, y1 - y0 + 1, rows.source, rows.context);
+    target_.setRotation(0);
+    return;
+  }
+  // Whatever part of a text box survived is still drawn as a text box, so
+  // it leaves in one window instead of a run per glyph stroke.
+  const Text &text = texts_[run.text - 1];
+  rotateRect(x0, y0, x1, y1, static_cast<uint8_t>((4 - text.rotation) % 4), kSize);
+  target_.setRotation(text.rotation);
+  target_.drawTextBox(x0, y0, x1 - x0 + 1, y1 - y0 + 1, text.x, text.y, textChars_ + text.offset,
+                      text.color, run.color, text.size);
+  target_.setRotation(0);
+}
+
+void RecordingGraphics::endFrame() {
+  if (count_ == 0) return;
+  const uint8_t previous = target_.getRotation();
+  target_.setRotation(0);
+
+  // Counting sort by first row; recording order survives within a row.
+  uint16_t rowStart[kSize + 1] = {};
+  for (size_t i = 0; i < count_; ++i) {
+    ++rowStart[fills_[i].y0 + 1];
+  }
+  for (int16_t y = 0; y < kSize; ++y) {
+    rowStart[y + 1] += rowStart[y];
+  }
+  for (size_t i = 0; i < count_; ++i) {
+    order_[rowStart[fills_[i].y0]++] = static_cast<uint16_t>(i);
+  }
+
+  size_t next = 0;
+  uint16_t activeCount = 0;
+  runCount_[0] = runCount_[1] = 0;
+  for (int16_t y = 0; y < kSize; ++y) {
+    // Retire fills that ended on the previous row.
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < activeCount; ++i) {
+      if (fills_[active_[i]].y1 >= y) {
+        active_[kept++] = active_[i];
+      }
+    }
+    // Merge fills starting on this row, which arrive in recording order.
+    size_t end = next;
+    while (end < count_ && fills_[order_[end]].y0 == y) {
+      ++end;
+    }
+    int32_t a = static_cast<int32_t>(kept) - 1;
+    int32_t b = static_cast<int32_t>(end) - 1;
+    int32_t out = static_cast<int32_t>(kept + (end - next)) - 1;
+    while (b >= static_cast<int32_t>(next)) {
+      if (a >= 0 && active_[a] > order_[b]) {
+        active_[out--] = active_[a--];
+      } else {
+        active_[out--] = order_[b--];
+      }
+    }
+    activeCount = static_cast<uint16_t>(kept + (end - next));
+    next = end;
+
+    resolveRow(y, activeCount);
+  }
+  const Run *open = runs_[(kSize - 1) & 1];
+  for (uint16_t i = 0; i < runCount_[(kSize - 1) & 1]; ++i) {
+    emit(open[i], kSize - 1);
+  }
+
+  count_ = 0;
+  textCount_ = 0;
+  textBytes_ = 0;
+  rowsCount_ = 0;
+  target_.setRotation(previous);
+}
+
+void RecordingGraphics::resolveRow(int16_t y, uint16_t activeCount) {
+  // Paint the row in recording order so later fills win.
+  std::fill_n(owner_, kSize, kUncovered);
+  for (uint16_t i = 0; i < activeCount; ++i) {
+    const Fill &fill = fills_[active_[i]];
+    std::fill(owner_ + fill.x0, owner_ + fill.x1 + 1, active_[i]);
+  }
+
+  Run *current = runs_[y & 1];
+  uint16_t &currentCount = runCount_[y & 1];
+  const Run *previous = runs_[(y + 1) & 1];
+  const uint16_t previousCount = y > 0 ? runCount_[(y + 1) & 1] : 0;
+
+  currentCount = 0;
+  for (int16_t x = 0; x < kSize;) {
+    if (owner_[x] == kUncovered) {
+      ++x;
+      continue;
+    }
+    // Solid fills of one color merge; a text box only continues itself.
+    const int16_t start = x;
+    const Fill &first = fills_[owner_[x]];
+    while (x < kSize && owner_[x] != kUncovered) {
+      const Fill &fill = fills_[owner_[x]];
+      if (fill.text != first.text || fill.color != first.color) break;
+      ++x;
+    }
+    current[currentCount++] = Run{static_cast<uint8_t>(start), static_cast<uint8_t>(x - 1),
+                                  static_cast<uint8_t>(y), first.text, first.color};
+  }
+
+  // A run identical to one on the row above extends it; runs above that
+  // found no continuation are complete and go out now.
+  uint16_t p = 0;
+  for (uint16_t i = 0; i < currentCount; ++i) {
+    Run &run = current[i];
+    while (p < previousCount && previous[p].x0 < run.x0) {
+      emit(previous[p++], y - 1);
+    }
+    if (p < previousCount && previous[p].x0 == run.x0) {
+      if (previous[p].x1 == run.x1 && previous[p].text == run.text && previous[p].color == run.color) {
+        run.y0 = previous[p].y0;
+      } else {
+        emit(previous[p], y - 1);
+      }
+      ++p;
+    }
+  }
+  for (; p < previousCount; ++p) {
+    emit(previous[p], y - 1);
+  }
+}
+
+void RecordingGraphics::drawTextBox(int16_t x, int16_t y, int16_t w, int16_t h,
+                                    int16_t textX, int16_t textY,
+                                    const char *text,
+                                    uint16_t colorText, uint16_t colorBG,
+                                    uint8_t textSize) {
+  if (!text || w <= 0 || h <= 0) return;
+  int16_t x0 = std::max<int16_t>(x, 0);
+  int16_t y0 = std::max<int16_t>(y, 0);
+  int16_t x1 = std::min<int16_t>(x + w - 1, kSize - 1);
+  int16_t y1 = std::min<int16_t>(y + h - 1, kSize - 1);
+  if (x0 > x1 || y0 > y1 || !clips_.clip(x0, y0, x1, y1, rotation_)) return;
+
+  if (!fills_) {
+    const uint8_t previous = target_.getRotation();
+    target_.setRotation(rotation_);
+    target_.drawTextBox(x0, y0, x1 - x0 + 1, y1 - y0 + 1, textX, textY, text, colorText, colorBG, textSize);
+    target_.setRotation(previous);
+    return;
+  }
+
+  // The box is one opaque fill; only its first line is kept.
+  const size_t length = std::min(std::strcspn(text, "\n"), kTextBytes - 1);
+  if (count_ == capacity_ || textCount_ == kMaxTexts || textBytes_ + length + 1 > kTextBytes) {
+    endFrame();
+  }
+  std::memcpy(textChars_ + textBytes_, text, length);
+  textChars_[textBytes_ + length] = '\0';
+  texts_[textCount_++] = Text{textX, textY, colorText, static_cast<uint16_t>(textBytes_), textSize, rotation_};
+  textBytes_ += length + 1;
+  record(x0, y0, x1, y1, colorBG, textCount_);
+}
+
+void RecordingGraphics::drawRows(int16_t x, int16_t y, int16_t w, int16_t h, RowSource source, void *context) {
+  if (!source || w <= 0 || h <= 0) return;
+  int16_t x0 = std::max<int16_t>(x, 0);
+  int16_t y0 = std::max<int16_t>(y, 0);
+  int16_t x1 = std::min<int16_t>(x + w - 1, kSize - 1);
+  int16_t y1 = std::min<int16_t>(y + h - 1, kSize - 1);
+  if (x0 > x1 || y0 > y1 || !clips_.clip(x0, y0, x1, y1, rotation_)) return;
+
+  if (!fills_) {
+    const uint8_t previous = target_.getRotation();
+    target_.setRotation(rotation_);
+    target_.drawRows(x0, y0, x1 - x0 + 1, y1 - y0 + 1, source, context);
+    target_.setRotation(previous);
+    return;
+  }
+
+  if (count_ == capacity_ || rowsCount_ == kMaxRowSources) {
+    endFrame();
+  }
+  rows_[rowsCount_++] = Rows{source, context, rotation_};
+  record(x0, y0, x1, y1, 0, static_cast<uint8_t>(kMaxTexts + rowsCount_));
+}
+
+void RecordingGraphics::flush() {
+  endFrame();
+  target_.flush();
+}
+
+void RecordingGraphics::displayOn() {
+  endFrame();
+  target_.displayOn();
+}
+
+void RecordingGraphics::displayOff() {
+  endFrame();
+  target_.displayOff();
+}
+
+}  // namespace graphics
@@ -0,0 +1,353 @@
+#include "render_bench.h"
+
+#include <Arduino.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "driver/gpio.h"
+#include "esp_cpu.h"
+#include "hardware_pins.h"
+#include "image_pack.h"
+#include "pixel_kernels.h"
+#include "soc/gpio_struct.h"
+#include "sprite.h"
+#include "watchface.h"
+
+namespace render_bench {
+
+// Reaches the driver's private single-pixel write for the drawPixel case.
+struct PanelAccess {
+  static void drawPixel(graphics::Gc9a01Graphics &panel, int16_t x, int16_t y, uint16_t color) {
+    panel.drawPixel(x, y, color);
+  }
+};
+
+namespace {
+
+constexpr uint16_t kColorA = watchface::COLOR_FACE;
+constexpr uint16_t kColorB = watchface::COLOR_SEC_HAND;
+
+template <typename Fn>
+void measure(graphics::Gc9a01Graphics &panel, const char *name, uint16_t iterations, Fn &&draw) {
+  panel.waitForTransfers();
+  panel.resetTransferStats();
+  const uint32_t startUs = micros();
+  for (uint16_t i = 0; i < iterations; ++i) {
+    draw(i);
+  }
+  panel.flush();
+  panel.waitForTransfers();
+  const uint32_t elapsedUs = micros() - startUs;
+  const graphics::TransferStats &stats = panel.transferStats();
+  Serial.printf("[bench] %-26s %7lu us %7lu B %5lu win /call\n",
+                name,
+                static_cast<unsigned long>(elapsedUs / iterations),
+                static_cast<unsigned long>(stats.bytes / iterations),
+                static_cast<unsigned long>(stats.windows / iterations));
+}
+
+// Splits CPU cycles into the part spent issuing calls and the part spent
+// waiting for the bus, which is where per-transaction overhead shows up.
+template <typename Fn>
+void measureCycles(graphics::Gc9a01Graphics &panel, const char *name, uint16_t iterations, Fn &&draw) {
+  panel.waitForTransfers();
+  const uint32_t start = esp_cpu_get_cycle_count();
+  for (uint16_t i = 0; i < iterations; ++i) {
+    draw(i);
+  }
+  const uint32_t issued = esp_cpu_get_cycle_count() - start;
+  panel.waitForTransfers();
+  const uint32_t total = esp_cpu_get_cycle_count() - start;
+  Serial.printf("[bench] %-26s %7lu cyc issue %7lu cyc done /call\n",
+                name,
+                static_cast<unsigned long>(issued / iterations),
+                static_cast<unsigned long>(total / iterations));
+}
+
+// The midpoint fillCircle the driver used before the span rasterizer: four
+// horizontal lines per step, many rows emitted more than once.
+void legacyFillCircle(graphics::Graphics &display, int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  display.fillRect(x0 - r, y0, 2 * r + 1, 1, color);
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    display.fillRect(x0 - x, y0 + y, 2 * x + 1, 1, color);
+    display.fillRect(x0 - x, y0 - y, 2 * x + 1, 1, color);
+    display.fillRect(x0 - y, y0 + x, 2 * y + 1, 1, color);
+    display.fillRect(x0 - y, y0 - x, 2 * y + 1, 1, color);
+  }
+}
+
+void runCircleCases(graphics::Gc9a01Graphics &panel) {
+  using watchface::CENTER_X;
+  using watchface::CENTER_Y;
+  measure(panel, "fillCircle r6 (midpoint)", 200, [&](uint16_t i) {
+    legacyFillCircle(panel, CENTER_X, CENTER_Y, 6, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "fillCircle r6", 200, [&](uint16_t i) {
+    panel.fillCircle(CENTER_X, CENTER_Y, 6, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "fillCircle r3 (midpoint)", 200, [&](uint16_t i) {
+    legacyFillCircle(panel, CENTER_X, CENTER_Y, 3, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "fillCircle r3", 200, [&](uint16_t i) {
+    panel.fillCircle(CENTER_X, CENTER_Y, 3, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "fillCircle r60 (midpoint)", 20, [&](uint16_t i) {
+    legacyFillCircle(panel, CENTER_X, CENTER_Y, 60, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "fillCircle r60", 20, [&](uint16_t i) {
+    panel.fillCircle(CENTER_X, CENTER_Y, 60, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "fillRing 118/112", 20, [&](uint16_t i) {
+    panel.fillRing(CENTER_X, CENTER_Y, 118, 112, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "fillArc 118/112 270deg", 20, [&](uint16_t i) {
+    panel.fillArc(CENTER_X, CENTER_Y, 118, 112, -90, 180, (i & 1) ? kColorA : kColorB);
+  });
+}
+
+void runBatchCases(graphics::Gc9a01Graphics &panel) {
+  using watchface::CENTER_X;
+  using watchface::CENTER_Y;
+  // A hand with a shallow tail, one segment per call against one polyline.
+  const graphics::Point hand[3] = {
+    {static_cast<int16_t>(CENTER_X - 14), static_cast<int16_t>(CENTER_Y + 5)},
+    {CENTER_X, CENTER_Y},
+    {static_cast<int16_t>(CENTER_X + 37), static_cast<int16_t>(CENTER_Y - 93)},
+  };
+  measure(panel, "drawLine x2 (hand+tail)", 100, [&](uint16_t i) {
+    const uint16_t color = (i & 1) ? kColorA : kColorB;
+    panel.drawLine(hand[1].x, hand[1].y, hand[2].x, hand[2].y, color);
+    panel.drawLine(hand[1].x, hand[1].y, hand[0].x, hand[0].y, color);
+  });
+  measure(panel, "drawPolyline (hand+tail)", 100, [&](uint16_t i) {
+    panel.drawPolyline(hand, 3, 1, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "drawWideLine w3", 100, [&](uint16_t i) {
+    panel.drawWideLine(hand[1].x, hand[1].y, hand[2].x, hand[2].y, 3, (i & 1) ? kColorA : kColorB);
+  });
+  measure(panel, "drawPolyline w3", 100, [&](uint16_t i) {
+    panel.drawPolyline(hand + 1, 2, 3, (i & 1) ? kColorA : kColorB);
+  });
+}
+
+// CPU cost of rasterizing, with the framebuffer taking the pixels so the
+// bus stays out of it. The backends are final, so a call through the panel
+// itself binds at compile time while one through Graphics& goes through
+// the vtable. The face is templated on its display; the two drawFull cases
+// are the same code instantiated for each.
+void runFrameCases(graphics::Gc9a01Graphics &panel) {
+  using watchface::CENTER_X;
+  using watchface::CENTER_Y;
+  if (!panel.setFramebufferEnabled(true)) return;
+  graphics::Graphics &display = panel;
+  measureCycles(panel, "fillRect 4x4 (direct)", 500, [&](uint16_t i) {
+    panel.fillRect(CENTER_X + (i & 15), CENTER_Y, 4, 4, (i & 1) ? kColorA : kColorB);
+  });
+  measureCycles(panel, "fillRect 4x4 (virtual)", 500, [&](uint16_t i) {
+    display.fillRect(CENTER_X + (i & 15), CENTER_Y, 4, 4, (i & 1) ? kColorA : kColorB);
+  });
+  measureCycles(panel, "drawFull into framebuffer (virtual)", 10, [&](uint16_t) {
+    watchface::drawFull(display);
+  });
+  measureCycles(panel, "drawFull into framebuffer (direct)", 10, [&](uint16_t) {
+    watchface::drawFull(panel);
+  });
+  panel.setFramebufferEnabled(false);
+}
+
+// A minute hand as a sprite, rotated afresh and replayed from the cache,
+// against the 3 px polyline it replaces; all into the framebuffer, so only
+// the CPU is timed.
+void runSpriteCases(graphics::Gc9a01Graphics &panel) {
+  using watchface::CENTER_X;
+  using watchface::CENTER_Y;
+  constexpr uint16_t kWidth = 201;
+  constexpr uint16_t kHeight = 7;
+  static uint16_t pixels[kWidth * kHeight];
+  // Tapered bar from the pivot at the center out to the right edge.
+  for (uint16_t v = 0; v < kHeight; ++v) {
+    for (uint16_t u = 0; u < kWidth; ++u) {
+      const int half = u < kWidth / 2 ? -1 : (kHeight / 2) * (kWidth - u) / (kWidth / 2);
+      const bool inside = std::abs(v - kHeight / 2) <= half;
+      pixels[v * kWidth + u] = inside ? kColorA : watchface::COLOR_BG;
+    }
+  }
+  graphics::Sprite sprite;
+  sprite.pixels = pixels;
+  sprite.width = kWidth;
+  sprite.height = kHeight;
+  sprite.pivotX = kWidth / 2;
+  sprite.pivotY = kHeight / 2;
+  graphics::RotatedSpriteCache cache;
+  const bool cached = cache.begin(sprite, 60, 48 * 1024);
+
+  if (!panel.setFramebufferEnabled(true)) return;
+  const float length = watchface::RADIUS * 0.84f;
+  measureCycles(panel, "hand drawPolyline w3", 60, [&](uint16_t i) {
+    const float angle = i * 6.0f * watchface::DEGREES_TO_RAD;
+    const graphics::Point hand[2] = {
+      {CENTER_X, CENTER_Y},
+      {static_cast<int16_t>(CENTER_X + std::lround(std::cos(angle) * length)),
+       static_cast<int16_t>(CENTER_Y + std::lround(std::sin(angle) * length))},
+    };
+    panel.drawPolyline(hand, 2, 3, kColorA);
+  });
+  measureCycles(panel, "hand sprite rotated", 60, [&](uint16_t i) {
+    graphics::drawRotatedSprite(panel, sprite, CENTER_X, CENTER_Y, static_cast<int16_t>(i * 60));
+  });
+  if (cached) {
+    measureCycles(panel, "hand sprite first draw", 60, [&](uint16_t i) {
+      cache.draw(panel, CENTER_X, CENTER_Y, i);
+    });
+    measureCycles(panel, "hand sprite cached", 60, [&](uint16_t i) {
+      cache.draw(panel, CENTER_X, CENTER_Y, i);
+    });
+  }
+  panel.setFramebufferEnabled(false);
+}
+
+// Decoding must outpace the wire: at 40 MHz a 16-bit pixel leaves every
+// 0.4 us, so anything below 64 cycles per pixel at 160 MHz keeps up.
+void runImageCases(graphics::Gc9a01Graphics &panel) {
+  image_pack::Image image;
+  if (!image_pack::imageAt(0, image)) {
+    Serial.println("[bench] no image pack, image cases skipped");
+    return;
+  }
+  uint16_t row[240];
+  const uint32_t start = esp_cpu_get_cycle_count();
+  for (uint16_t y = 0; y < image.height; ++y) {
+    image_pack::readRow(&image, static_cast<int16_t>(y), 0, static_cast<int16_t>(image.width - 1), row);
+  }
+  const uint32_t cycles = esp_cpu_get_cycle_count() - start;
+  Serial.printf("[bench] image %ux%u decode %lu cyc/px\n",
+                static_cast<unsigned>(image.width), static_cast<unsigned>(image.height),
+                static_cast<unsigned long>(cycles / (static_cast<uint32_t>(image.width) * image.height)));
+  measure(panel, "drawImage", 5, [&](uint16_t) {
+    image_pack::drawImage(panel, image);
+  });
+}
+
+// Each kernel against its portable version over a panel row at an odd
+// offset, so the alignment edges are part of the cost; the two must agree
+// byte for byte. test/test_pixel_kernels covers every other alignment.
+void runKernelCases() {
+  constexpr size_t kPixels = 240;
+  constexpr uint16_t kRounds = 200;
+  alignas(16) static uint16_t source[kPixels + 2];
+  alignas(16) static uint16_t fast[kPixels + 1];
+  alignas(16) static uint16_t portable[kPixels + 1];
+  static uint8_t indices[kPixels + 2];
+  static uint16_t lut[256];
+  for (size_t i = 0; i <= kPixels + 1; ++i) {
+    source[i] = static_cast<uint16_t>(i * 0x9E37u);
+    indices[i] = static_cast<uint8_t>(i * 7);
+  }
+  for (uint16_t i = 0; i < 256; ++i) {
+    lut[i] = static_cast<uint16_t>(i * 0x0841u);
+  }
+  auto compare = [&](const char *name, auto &&kernel, auto &&reference) {
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint16_t i = 0; i < kRounds; ++i) {
+      kernel(fast + 1);
+    }
+    const uint32_t fastCycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    for (uint16_t i = 0; i < kRounds; ++i) {
+      reference(portable + 1);
+    }
+    const uint32_t portableCycles = esp_cpu_get_cycle_count() - start;
+    const bool same = std::memcmp(fast + 1, portable + 1, kPixels * sizeof(uint16_t)) == 0;
+    Serial.printf("[bench] %-26s %7lu cyc %7lu cyc portable /row%s\n",
+                  name,
+                  static_cast<unsigned long>(fastCycles / kRounds),
+                  static_cast<unsigned long>(portableCycles / kRounds),
+                  same ? "" : " MISMATCH");
+  };
+  namespace px = graphics::pixels;
+  compare("kernel fill", [&](uint16_t *d) { px::fill(d, kColorA, kPixels); },
+          [&](uint16_t *d) { px::portable::fill(d, kColorA, kPixels); });
+  compare("kernel swapBytes", [&](uint16_t *d) { px::swapBytes(d, source + 1, kPixels); },
+          [&](uint16_t *d) { px::portable::swapBytes(d, source + 1, kPixels); });
+  // Source and dest at different offsets within 16 bytes: no vector path.
+  compare("kernel swapBytes skewed", [&](uint16_t *d) { px::swapBytes(d, source + 2, kPixels); },
+          [&](uint16_t *d) { px::portable::swapBytes(d, source + 2, kPixels); });
+  compare("kernel expand8", [&](uint16_t *d) { px::expand8(d, indices + 1, kPixels, lut); },
+          [&](uint16_t *d) { px::portable::expand8(d, indices + 1, kPixels, lut); });
+  compare("kernel expand4", [&](uint16_t *d) { px::expand4(d, indices, 1, kPixels, lut); },
+          [&](uint16_t *d) { px::portable::expand4(d, indices, 1, kPixels, lut); });
+  compare("kernel expand1", [&](uint16_t *d) { px::expand1(d, indices, 1, kPixels, kColorA, 0); },
+          [&](uint16_t *d) { px::portable::expand1(d, indices, 1, kPixels, kColorA, 0); });
+  // In place, so both buffers must start alike: the cases above left the
+  // same row in each.
+  compare("kernel blend", [&](uint16_t *d) { px::blend(d, source + 1, 12, kPixels); },
+          [&](uint16_t *d) { px::portable::blend(d, source + 1, 12, kPixels); });
+  compare("kernel packRgb444", [&](uint16_t *d) { px::packRgb444(reinterpret_cast<uint8_t *>(d), source, kPixels / 2); },
+          [&](uint16_t *d) { px::portable::packRgb444(reinterpret_cast<uint8_t *>(d), source, kPixels / 2); });
+}
+
+void runTransactionCases(graphics::Gc9a01Graphics &panel) {
+  using watchface::CENTER_X;
+  using watchface::CENTER_Y;
+  // The DC write the pre-transfer callback does for every descriptor, old
+  // and new way, with the bus idle so the toggles are harmless.
+  const gpio_num_t dc = static_cast<gpio_num_t>(pins::LCD_DC);
+  const uint32_t dcMask = 1u << pins::LCD_DC;
+  measureCycles(panel, "dc gpio_set_level", 1000, [&](uint16_t i) {
+    gpio_set_level(dc, i & 1);
+  });
+  measureCycles(panel, "dc w1ts/w1tc", 1000, [&](uint16_t i) {
+    if (i & 1) {
+      GPIO.out_w1ts = dcMask;
+    } else {
+      GPIO.out_w1tc = dcMask;
+    }
+  });
+  gpio_set_level(dc, 1);
+
+  measureCycles(panel, "drawPixel", 500, [&](uint16_t i) {
+    PanelAccess::drawPixel(panel, CENTER_X + (i & 15), CENTER_Y, (i & 1) ? kColorA : kColorB);
+  });
+  measureCycles(panel, "fillSpan 16px", 500, [&](uint16_t i) {
+    panel.fillSpan(CENTER_X - 8, CENTER_X + 7, CENTER_Y + (i & 15), (i & 1) ? kColorA : kColorB);
+  });
+  measureCycles(panel, "fillSpan 240px", 200, [&](uint16_t i) {
+    panel.fillSpan(0, 239, CENTER_Y + (i & 15), (i & 1) ? kColorA : kColorB);
+  });
+}
+
+}  // namespace
+
+void run(graphics::Gc9a01Graphics &panel) {
+  const bool hadFramebuffer = panel.framebufferEnabled();
+  panel.setFramebufferEnabled(false);
+
+  Serial.println("[bench] renderer microbenchmarks");
+  runTransactionCases(panel);
+  runCircleCases(panel);
+  runBatchCases(panel);
+  runFrameCases(panel);
+  runSpriteCases(panel);
+  runImageCases(panel);
+  runKernelCases();
+
+  panel.fillScreen(watchface::COLOR_BG);
+  panel.waitForTransfers();
+  panel.setFramebufferEnabled(hadFramebuffer);
+}
+
+}  // namespace render_bench
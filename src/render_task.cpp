@@ -0,0 +1,248 @@
+#include "render_task.h"
+
+#include <Arduino.h>
+#include <atomic>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "debug_log.h"
+#include "display_manager.h"
+#include "info_screen.h"
+#include "watchface.h"
+
+#ifndef HACKTOR_RENDER_TASK
+#define HACKTOR_RENDER_TASK 1
+#endif
+
+#ifndef HACKTOR_RENDER_BUDGET_US
+#define HACKTOR_RENDER_BUDGET_US 4000
+#endif
+
+namespace render_task {
+namespace {
+
+#if defined(CONFIG_FREERTOS_UNICORE) && CONFIG_FREERTOS_UNICORE
+constexpr bool kHaveSecondCore = false;
+constexpr BaseType_t kRenderTaskCore = tskNO_AFFINITY;
+#else
+constexpr bool kHaveSecondCore = true;
+// The Arduino loop runs on the other core.
+constexpr BaseType_t kRenderTaskCore = ARDUINO_RUNNING_CORE == 0 ? 1 : 0;
+#endif
+
+// Row buffers of the renderers live on the stack.
+constexpr uint32_t kRenderTaskStack = 8192;
+
+// Single-producer, single-consumer ring: the loop pushes, the render task
+// pops. Each side only writes its own index, so no lock is needed.
+template <typename T, uint8_t kCapacity>
+class FrameQueue {
+  static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be a power of two");
+
+ public:
+  bool push(const T &item) {
+    const uint8_t tail = tail_.load(std::memory_order_relaxed);
+    if (static_cast<uint8_t>(tail - head_.load(std::memory_order_acquire)) == kCapacity) return false;
+    items_[tail & (kCapacity - 1)] = item;
+    tail_.store(static_cast<uint8_t>(tail + 1), std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &item) {
+    const uint8_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    item = items_[head & (kCapacity - 1)];
+    head_.store(static_cast<uint8_t>(head + 1), std::memory_order_release);
+    return true;
+  }
+
+ private:
+  T items_[kCapacity];
+  std::atomic<uint8_t> head_{0};
+  std::atomic<uint8_t> tail_{0};
+};
+
+// A frame being drawn, from its request to its flush.
+struct Frame {
+  FrameRequest request;
+  bool full = false;
+  bool open = false;
+  // Requests folded into it, steps painted and calls it spanned.
+  uint32_t merged = 0;
+  uint16_t steps = 0;
+  uint16_t passes = 0;
+  uint32_t startUs = 0;
+};
+
+FrameQueue<FrameRequest, 4> s_queue;
+TaskHandle_t s_task = nullptr;
+// Frames submitted by the loop and frames drawn and flushed since.
+uint32_t s_submitted = 0;
+std::atomic<uint32_t> s_done{0};
+
+// Everything below is only touched by whichever side draws: the render
+// task, or the loop without it.
+Frame s_frame;
+// Requests waiting for the open frame, folded into the newest. The face
+// is retained, so updating straight to the newest state repaints all that
+// changed since the last frame.
+FrameRequest s_latest;
+uint32_t s_waiting = 0;
+bool s_fullPending = false;
+
+void take(const FrameRequest &request) {
+  s_latest = request;
+  s_fullPending |= request.kind == FrameRequest::Kind::WatchfaceFull;
+  ++s_waiting;
+}
+
+bool paintsInOneStep(const Frame &frame) {
+  // The info screen is a single step, as is a banded full paint, which
+  // replays the whole face once per strip.
+  return frame.request.kind == FrameRequest::Kind::Info ||
+         (frame.full && display_manager::bandedRendering());
+}
+
+void openFrame() {
+  s_frame.request = s_latest;
+  s_frame.merged = s_waiting;
+  s_frame.steps = 0;
+  s_frame.passes = 0;
+  s_frame.startUs = micros();
+  s_frame.open = true;
+  s_waiting = 0;
+  const FrameRequest &request = s_frame.request;
+  s_frame.full = false;
+  if (request.kind != FrameRequest::Kind::Info) {
+    // A full paint asked for while the info screen was shown still counts.
+    s_frame.full = s_fullPending;
+    s_fullPending = false;
+    watchface::update(request.time, request.steps, request.batteryPercent);
+    if (!paintsInOneStep(s_frame)) watchface::beginFrame(s_frame.full);
+  }
+#if HACKTOR_DEBUG_LEVEL >= 1
+  display_manager::resetTransferStats();
+#endif
+}
+
+// Paints the next step of the open frame; false once it is complete.
+bool drawStep() {
+  ++s_frame.steps;
+  const FrameRequest &request = s_frame.request;
+  if (request.kind == FrameRequest::Kind::Info) {
+    display_manager::renderFrame([&](auto &frame) {
+      info_screen::draw(frame, request.stats, request.time, request.batteryPercent, request.batteryVoltage);
+    });
+    return false;
+  }
+  if (paintsInOneStep(s_frame)) {
+    display_manager::renderFrame([](auto &display) { watchface::drawFull(display); });
+    return false;
+  }
+  return display_manager::withDisplay([](auto &display) { return watchface::drawStep(display); });
+}
+
+void closeFrame() {
+  display_manager::get().flush();
+  s_frame.open = false;
+#if HACKTOR_DEBUG_LEVEL >= 1
+  const graphics::TransferStats stats = display_manager::transferStats();
+  LOG_PRINTF(1, "[render] %lu request(s), %u steps in %u pass(es), %lu B, %lu windows, %lu tx, %lu us\n",
+             static_cast<unsigned long>(s_frame.merged),
+             static_cast<unsigned>(s_frame.steps),
+             static_cast<unsigned>(s_frame.passes),
+             static_cast<unsigned long>(stats.bytes),
+             static_cast<unsigned long>(stats.windows),
+             static_cast<unsigned long>(stats.transactions),
+             static_cast<unsigned long>(micros() - s_frame.startUs));
+#endif
+  s_done.fetch_add(s_frame.merged, std::memory_order_release);
+}
+
+// Paints steps of waiting frames until `budgetUs` has passed; 0 means until
+// none are left. At least one step is painted per call, so frames always
+// progress.
+void drawFor(uint32_t budgetUs) {
+  const uint32_t startUs = micros();
+  bool counted = false;
+  while (s_frame.open || s_waiting > 0) {
+    if (!s_frame.open) {
+      openFrame();
+      counted = false;
+    }
+    if (!counted) {
+      ++s_frame.passes;
+      counted = true;
+    }
+    if (!drawStep()) closeFrame();
+    if (budgetUs > 0 && micros() - startUs >= budgetUs) return;
+  }
+}
+
+void renderLoop(void *) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    FrameRequest request;
+    while (s_queue.pop(request)) {
+      take(request);
+    }
+    drawFor(0);
+  }
+}
+
+}  // namespace
+
+bool start() {
+  if (!HACKTOR_RENDER_TASK || !kHaveSecondCore) return false;
+  if (s_task) return true;
+  // Whatever the loop queued so far is finished first.
+  waitIdle();
+  const BaseType_t created = xTaskCreatePinnedToCore(
+      renderLoop,
+      "render",
+      kRenderTaskStack,
+      nullptr,
+      1,
+      &s_task,
+      kRenderTaskCore);
+  if (created != pdPASS) {
+    s_task = nullptr;
+    LOG_PRINT(1, "[render] task not created; drawing in the loop");
+    return false;
+  }
+  return true;
+}
+
+bool running() {
+  return s_task != nullptr;
+}
+
+void submit(const FrameRequest &request) {
+  ++s_submitted;
+  if (!s_task) {
+    take(request);
+    return;
+  }
+  while (!s_queue.push(request)) {
+    vTaskDelay(1);
+  }
+  xTaskNotifyGive(s_task);
+}
+
+void service() {
+  if (s_task) return;
+  drawFor(HACKTOR_RENDER_BUDGET_US);
+}
+
+void waitIdle() {
+  if (!s_task) {
+    drawFor(0);
+    return;
+  }
+  while (s_done.load(std::memory_order_acquire) != s_submitted) {
+    vTaskDelay(1);
+  }
+}
+
+}  // namespace render_task
@@ -0,0 +1,285 @@
+#include "spi_dma_bus.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "pixel_kernels.h"
+#include "soc/gpio_struct.h"
+
+namespace {
+
+// The DC level travels with each descriptor so the callback needs no state.
+inline void *dcTag(int pin, bool isData) {
+  return reinterpret_cast<void *>(static_cast<uintptr_t>((pin << 1) | (isData ? 1 : 0)));
+}
+
+// A single store to the GPIO set/clear registers: stays in IRAM and skips
+// the argument checks gpio_set_level() runs for every transaction.
+void IRAM_ATTR setDcBeforeTransfer(spi_transaction_t *t) {
+  const uintptr_t tag = reinterpret_cast<uintptr_t>(t->user);
+  const uint32_t pin = tag >> 1;
+  if (pin < 32) {
+    if (tag & 1) {
+      GPIO.out_w1ts = 1u << pin;
+    } else {
+      GPIO.out_w1tc = 1u << pin;
+    }
+  } else {
+    if (tag & 1) {
+      GPIO.out1_w1ts.val = 1u << (pin - 32);
+    } else {
+      GPIO.out1_w1tc.val = 1u << (pin - 32);
+    }
+  }
+}
+
+}  // namespace
+
+namespace graphics {
+
+SpiDmaBus::~SpiDmaBus() {
+  end();
+  for (auto &buffer : staging_) {
+    heap_caps_free(buffer);
+    buffer = nullptr;
+  }
+}
+
+bool SpiDmaBus::begin(spi_host_device_t host, int pin_sck, int pin_mosi, int pin_cs, int pin_dc, uint32_t freq_hz) {
+  end();
+
+  for (auto &buffer : staging_) {
+    if (!buffer) {
+      buffer = static_cast<uint8_t *>(heap_caps_malloc(kStagingBytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+      if (!buffer) {
+        return false;
+      }
+    }
+  }
+
+  host_ = host;
+  dc_ = pin_dc;
+  gpio_config_t dcConfig = {};
+  dcConfig.pin_bit_mask = 1ULL << pin_dc;
+  dcConfig.mode = GPIO_MODE_OUTPUT;
+  gpio_config(&dcConfig);
+  gpio_set_level(static_cast<gpio_num_t>(pin_dc), 1);
+
+  spi_bus_config_t busConfig = {};
+  busConfig.mosi_io_num = pin_mosi;
+  busConfig.miso_io_num = -1;
+  busConfig.sclk_io_num = pin_sck;
+  busConfig.quadwp_io_num = -1;
+  busConfig.quadhd_io_num = -1;
+  busConfig.max_transfer_sz = kMaxTransferBytes;
+  if (spi_bus_initialize(host_, &busConfig, SPI_DMA_CH_AUTO) != ESP_OK) {
+    return false;
+  }
+
+  spi_device_interface_config_t deviceConfig = {};
+  deviceConfig.mode = 0;
+  deviceConfig.clock_speed_hz = static_cast<int>(freq_hz);
+  deviceConfig.spics_io_num = pin_cs;
+  deviceConfig.queue_size = kQueueDepth;
+  deviceConfig.pre_cb = setDcBeforeTransfer;
+  if (spi_bus_add_device(host_, &deviceConfig, &device_) != ESP_OK) {
+    spi_bus_free(host_);
+    device_ = nullptr;
+    return false;
+  }
+
+  // end() left nothing in flight. The sequence numbers carry on, so ones
+  // callers kept from before a restart still read as complete.
+  head_ = 0;
+  inFlight_ = 0;
+  activeStaging_ = 0;
+  patternStaging_ = kNoPattern;
+  return true;
+}
+
+void SpiDmaBus::end() {
+  if (!device_) {
+    return;
+  }
+  waitIdle();
+  spi_bus_remove_device(device_);
+  spi_bus_free(host_);
+  device_ = nullptr;
+}
+
+void SpiDmaBus::command(uint8_t cmd) {
+  queueInline(&cmd, 1, false);
+}
+
+void SpiDmaBus::data(const uint8_t *bytes, size_t len) {
+  if (len <= 4) {
+    queueInline(bytes, len, true);
+    return;
+  }
+  while (len > 0) {
+    size_t batch = std::min(len, kStagingBytes);
+    std::memcpy(stagingBuffer(), bytes, batch);
+    submitStaging(batch);
+    bytes += batch;
+    len -= batch;
+  }
+}
+
+void SpiDmaBus::setWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+  // Five small descriptors carrying their payload inline, so the address
+  // phase never waits on a staging buffer.
+  const uint8_t columns[4] = {
+    static_cast<uint8_t>(x0 >> 8), static_cast<uint8_t>(x0),
+    static_cast<uint8_t>(x1 >> 8), static_cast<uint8_t>(x1)
+  };
+  const uint8_t rows[4] = {
+    static_cast<uint8_t>(y0 >> 8), static_cast<uint8_t>(y0),
+    static_cast<uint8_t>(y1 >> 8), static_cast<uint8_t>(y1)
+  };
+  command(0x2A);
+  queueInline(columns, 4, true);
+  command(0x2B);
+  queueInline(rows, 4, true);
+  command(0x2C);
+  ++stats_.windows;
+}
+
+uint8_t *SpiDmaBus::stagingBuffer() {
+  waitForSequence(stagingSeq_[activeStaging_]);
+  if (patternStaging_ == activeStaging_) {
+    patternStaging_ = kNoPattern;
+  }
+  return staging_[activeStaging_];
+}
+
+void SpiDmaBus::submitStaging(size_t len) {
+  if (len > 0) {
+    queueBytes(staging_[activeStaging_], len);
+    stagingSeq_[activeStaging_] = queuedSeq_;
+  }
+  activeStaging_ ^= 1;
+}
+
+void SpiDmaBus::fill16(uint16_t value, size_t count) {
+  fillPattern(value, count, 16);
+}
+
+void SpiDmaBus::fill12(uint16_t value, size_t count) {
+  fillPattern(value & 0x0FFF, count, 12);
+}
+
+void SpiDmaBus::fillPattern(uint16_t value, size_t count, uint8_t bitsPerPixel) {
+  if (count == 0) {
+    return;
+  }
+  // 12-bit patterns hold whole pixel pairs so every chunk but the last
+  // starts on a byte boundary.
+  const size_t stagingPixels = bitsPerPixel == 12 ? (kStagingBytes / 3) * 2 : kStagingBytes / 2;
+  const bool reusable = patternStaging_ != kNoPattern && patternValue_ == value && patternBits_ == bitsPerPixel &&
+                        (count <= patternPixels_ || patternPixels_ == stagingPixels);
+  if (!reusable) {
+    size_t patternPixels = std::min(std::max(count, kMinPatternPixels), stagingPixels);
+    uint8_t *pattern = stagingBuffer();
+    if (bitsPerPixel == 12) {
+      patternPixels = (patternPixels + 1) & ~static_cast<size_t>(1);
+      const uint8_t b0 = static_cast<uint8_t>(value >> 4);
+      const uint8_t b1 = static_cast<uint8_t>(((value & 0x0F) << 4) | (value >> 8));
+      const uint8_t b2 = static_cast<uint8_t>(value & 0xFF);
+      for (size_t i = 0; i < patternPixels / 2; ++i) {
+        pattern[3 * i] = b0;
+        pattern[3 * i + 1] = b1;
+        pattern[3 * i + 2] = b2;
+      }
+    } else {
+      // Big-endian on the wire: high byte first in memory.
+      const uint16_t wire = static_cast<uint16_t>((value >> 8) | (value << 8));
+      pixels::fill(reinterpret_cast<uint16_t *>(pattern), wire, patternPixels);
+    }
+    patternStaging_ = activeStaging_;
+    patternValue_ = value;
+    patternBits_ = bitsPerPixel;
+    patternPixels_ = patternPixels;
+    activeStaging_ ^= 1;
+  }
+
+  // The staged pattern backs every chunk of this run and of later runs in
+  // the same color until its buffer is handed out again.
+  const uint8_t *pattern = staging_[patternStaging_];
+  while (count > 0) {
+    size_t batch = std::min(count, patternPixels_);
+    queueBytes(pattern, (batch * bitsPerPixel + 7) / 8);
+    count -= batch;
+  }
+  stagingSeq_[patternStaging_] = queuedSeq_;
+}
+
+void SpiDmaBus::writeDma(const uint8_t *bytes, size_t len) {
+  while (len > 0) {
+    size_t batch = std::min(len, kMaxTransferBytes);
+    queueBytes(bytes, batch);
+    bytes += batch;
+    len -= batch;
+  }
+}
+
+void SpiDmaBus::waitIdle() {
+  while (inFlight_ > 0) {
+    reclaimOne();
+  }
+}
+
+spi_transaction_t &SpiDmaBus::nextDescriptor() {
+  if (inFlight_ == kQueueDepth) {
+    reclaimOne();
+  }
+  spi_transaction_t &t = ring_[head_];
+  head_ = static_cast<uint8_t>((head_ + 1) % kQueueDepth);
+  std::memset(&t, 0, sizeof(t));
+  return t;
+}
+
+void SpiDmaBus::queue(spi_transaction_t &t) {
+  spi_device_queue_trans(device_, &t, portMAX_DELAY);
+  ++inFlight_;
+  ++queuedSeq_;
+  stats_.bytes += t.length / 8;
+  ++stats_.transactions;
+}
+
+void SpiDmaBus::queueBytes(const uint8_t *bytes, size_t len) {
+  spi_transaction_t &t = nextDescriptor();
+  t.length = len * 8;
+  t.tx_buffer = bytes;
+  t.user = dcTag(dc_, true);
+  queue(t);
+}
+
+void SpiDmaBus::queueInline(const uint8_t *bytes, size_t len, bool isData) {
+  if (len == 0) {
+    return;
+  }
+  spi_transaction_t &t = nextDescriptor();
+  t.flags = SPI_TRANS_USE_TXDATA;
+  t.length = len * 8;
+  std::memcpy(t.tx_data, bytes, len);
+  t.user = dcTag(dc_, isData);
+  queue(t);
+}
+
+void SpiDmaBus::reclaimOne() {
+  spi_transaction_t *done = nullptr;
+  spi_device_get_trans_result(device_, &done, portMAX_DELAY);
+  --inFlight_;
+  ++completedSeq_;
+}
+
+void SpiDmaBus::waitForSequence(uint32_t seq) {
+  while (static_cast<int32_t>(completedSeq_ - seq) < 0) {
+    reclaimOne();
+  }
+}
+
+}  // namespace graphics
@@ -0,0 +1,296 @@
+#include "sprite.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "esp_heap_caps.h"
+
+namespace graphics {
+namespace {
+
+// offsets_ markers: not rotated yet, or drawn without the cache.
+constexpr uint32_t kNotBuilt = UINT32_MAX;
+constexpr uint32_t kUncached = UINT32_MAX - 1;
+// A cached span: int8 x0, x1 and y from the pivot, then its color.
+constexpr size_t kCachedSpanBytes = 5;
+
+// 16.16 cosine and sine of the angle.
+struct Turn {
+  int32_t c;
+  int32_t s;
+};
+
+Turn turnFor(int16_t angle) {
+  const float radians = static_cast<float>(angle) * (3.14159265f / 1800.0f);
+  return {static_cast<int32_t>(std::lround(std::cos(radians) * 65536.0f)),
+          static_cast<int32_t>(std::lround(std::sin(radians) * 65536.0f))};
+}
+
+inline int32_t floorDiv(int32_t a, int32_t b) {
+  int32_t q = a / b;
+  if ((a % b != 0) && ((a < 0) != (b < 0))) --q;
+  return q;
+}
+
+inline int32_t ceilDiv(int32_t a, int32_t b) {
+  return -floorDiv(-a, b);
+}
+
+// Narrows [lo, hi] to the steps i where (start + i * step) >> 16 falls in
+// 0..limit - 1, so the pixel loop needs no bounds test.
+void narrow(int32_t start, int32_t step, int32_t limit, int32_t &lo, int32_t &hi) {
+  const int32_t top = (limit << 16) - 1;
+  if (step == 0) {
+    if (start < 0 || start > top) hi = lo - 1;
+    return;
+  }
+  if (step > 0) {
+    lo = std::max(lo, ceilDiv(-start, step));
+    hi = std::min(hi, floorDiv(top - start, step));
+  } else {
+    lo = std::max(lo, ceilDiv(top - start, step));
+    hi = std::min(hi, floorDiv(-start, step));
+  }
+}
+
+// Samples the sprite, pivot at (x, y), for every pixel of `area` and hands
+// each run of one opaque color to emit(x0, x1, y, color).
+template <typename Emit>
+void rotateRuns(const Sprite &sprite, int16_t x, int16_t y, int16_t angle, const Rect &area, Emit &&emit) {
+  const Turn turn = turnFor(angle);
+  const int32_t width = sprite.width;
+  for (int16_t row = area.y; row < area.y + area.h; ++row) {
+    const int32_t dx = area.x - x;
+    const int32_t dy = row - y;
+    // Sprite position of the row's first pixel center, with half a pixel
+    // added so the shifts below round to the nearest pixel.
+    const int32_t u = turn.c * dx + turn.s * dy + (static_cast<int32_t>(sprite.pivotX) << 16) + 0x8000;
+    const int32_t v = -turn.s * dx + turn.c * dy + (static_cast<int32_t>(sprite.pivotY) << 16) + 0x8000;
+    int32_t lo = 0;
+    int32_t hi = area.w - 1;
+    narrow(u, turn.c, width, lo, hi);
+    narrow(v, -turn.s, sprite.height, lo, hi);
+    if (lo > hi) continue;
+
+    int32_t su = u + turn.c * lo;
+    int32_t sv = v - turn.s * lo;
+    int32_t runStart = -1;
+    uint16_t runColor = 0;
+    for (int32_t i = lo; i <= hi; ++i, su += turn.c, sv -= turn.s) {
+      const uint16_t color = sprite.pixels[(sv >> 16) * width + (su >> 16)];
+      if (runStart >= 0 && color == runColor) continue;
+      if (runStart >= 0) {
+        emit(static_cast<int16_t>(area.x + runStart), static_cast<int16_t>(area.x + i - 1), row, runColor);
+      }
+      runStart = color == sprite.key ? -1 : i;
+      runColor = color;
+    }
+    if (runStart >= 0) {
+      emit(static_cast<int16_t>(area.x + runStart), static_cast<int16_t>(area.x + hi), row, runColor);
+    }
+  }
+}
+
+// Spans waiting for fillSpans, a few colors at a time. A sprite paints each
+// pixel once, so spans of different colors can go out in any order.
+class SpanBatches {
+ public:
+  explicit SpanBatches(Graphics &display) : display_(display) {}
+
+  SpanBatches(const SpanBatches &) = delete;
+  SpanBatches &operator=(const SpanBatches &) = delete;
+
+  ~SpanBatches() { flush(); }
+
+  void add(int16_t x0, int16_t x1, int16_t y, uint16_t color) {
+    Batch &batch = batchFor(color);
+    if (batch.count == kSpans) {
+      display_.fillSpans(batch.spans, batch.count, batch.color);
+      batch.count = 0;
+    }
+    batch.spans[batch.count++] = Span{x0, x1, y};
+  }
+
+  void flush() {
+    for (uint8_t i = 0; i < used_; ++i) {
+      if (batches_[i].count > 0) display_.fillSpans(batches_[i].spans, batches_[i].count, batches_[i].color);
+    }
+    used_ = 0;
+  }
+
+ private:
+  static constexpr uint8_t kColors = 4;
+  static constexpr uint16_t kSpans = 32;
+
+  struct Batch {
+    uint16_t color;
+    uint16_t count;
+    Span spans[kSpans];
+  };
+
+  Batch &batchFor(uint16_t color) {
+    for (uint8_t i = 0; i < used_; ++i) {
+      if (batches_[i].color == color) return batches_[i];
+    }
+    if (used_ == kColors) flush();
+    Batch &batch = batches_[used_++];
+    batch.color = color;
+    batch.count = 0;
+    return batch;
+  }
+
+  Graphics &display_;
+  Batch batches_[kColors];
+  uint8_t used_ = 0;
+};
+
+inline bool fitsInt8(int32_t low, int32_t high) {
+  return low >= INT8_MIN && high <= INT8_MAX;
+}
+
+}  // namespace
+
+Rect rotatedSpriteBounds(const Sprite &sprite, int16_t x, int16_t y, int16_t angle, int16_t u0, int16_t u1) {
+  const float radians = static_cast<float>(angle) * (3.14159265f / 1800.0f);
+  const float c = std::cos(radians);
+  const float s = std::sin(radians);
+  // Corners of the pixels' outer edges, relative to the pivot.
+  const float us[2] = {u0 - 0.5f - sprite.pivotX, u1 + 0.5f - sprite.pivotX};
+  const float vs[2] = {-0.5f - sprite.pivotY, sprite.height - 0.5f - sprite.pivotY};
+  float minX = 0.0f, maxX = 0.0f, minY = 0.0f, maxY = 0.0f;
+  bool first = true;
+  for (float u : us) {
+    for (float v : vs) {
+      const float px = c * u - s * v;
+      const float py = s * u + c * v;
+      minX = first ? px : std::min(minX, px);
+      maxX = first ? px : std::max(maxX, px);
+      minY = first ? py : std::min(minY, py);
+      maxY = first ? py : std::max(maxY, py);
+      first = false;
+    }
+  }
+  // Pixel centers inside the corners, with 1/64 px of slack for the
+  // rounding of the fixed-point sampling.
+  constexpr float kSlack = 1.0f / 64.0f;
+  const int16_t x0 = static_cast<int16_t>(x + static_cast<int16_t>(std::ceil(minX - kSlack)));
+  const int16_t y0 = static_cast<int16_t>(y + static_cast<int16_t>(std::ceil(minY - kSlack)));
+  const int16_t x1 = static_cast<int16_t>(x + static_cast<int16_t>(std::floor(maxX + kSlack)));
+  const int16_t y1 = static_cast<int16_t>(y + static_cast<int16_t>(std::floor(maxY + kSlack)));
+  return Rect{x0, y0, static_cast<int16_t>(x1 - x0 + 1), static_cast<int16_t>(y1 - y0 + 1)};
+}
+
+void drawRotatedSprite(Graphics &display, const Sprite &sprite, int16_t x, int16_t y, int16_t angle) {
+  if (!sprite.pixels || sprite.width == 0 || sprite.height == 0) return;
+  Rect area = rotatedSpriteBounds(sprite, x, y, angle, 0, static_cast<int16_t>(sprite.width - 1));
+  const int16_t x0 = std::max<int16_t>(area.x, 0);
+  const int16_t y0 = std::max<int16_t>(area.y, 0);
+  const int16_t x1 = std::min<int16_t>(area.x + area.w - 1, display.width() - 1);
+  const int16_t y1 = std::min<int16_t>(area.y + area.h - 1, display.height() - 1);
+  if (x0 > x1 || y0 > y1) return;
+  area = Rect{x0, y0, static_cast<int16_t>(x1 - x0 + 1), static_cast<int16_t>(y1 - y0 + 1)};
+
+  SpanBatches batches(display);
+  rotateRuns(sprite, x, y, angle, area, [&](int16_t a, int16_t b, int16_t row, uint16_t color) {
+    batches.add(a, b, row, color);
+  });
+}
+
+RotatedSpriteCache::~RotatedSpriteCache() {
+  heap_caps_free(offsets_);
+}
+
+bool RotatedSpriteCache::begin(const Sprite &sprite, uint16_t positions, size_t bytes) {
+  heap_caps_free(offsets_);
+  offsets_ = nullptr;
+  arena_ = nullptr;
+  capacity_ = 0;
+  used_ = 0;
+  sprite_ = sprite;
+  positions_ = std::max<uint16_t>(positions, 1);
+  firstOpaque_ = static_cast<int16_t>(sprite.width);
+  lastOpaque_ = -1;
+  if (sprite.pixels) {
+    for (uint16_t v = 0; v < sprite.height; ++v) {
+      for (uint16_t u = 0; u < sprite.width; ++u) {
+        if (sprite.pixels[v * sprite.width + u] == sprite.key) continue;
+        firstOpaque_ = std::min<int16_t>(firstOpaque_, static_cast<int16_t>(u));
+        lastOpaque_ = std::max<int16_t>(lastOpaque_, static_cast<int16_t>(u));
+      }
+    }
+  }
+
+  // Only the CPU reads the spans back, so external RAM is good enough;
+  // internal RAM is left to the frame buffers.
+  const size_t tableBytes = positions_ * sizeof(uint32_t);
+  void *block = heap_caps_malloc(tableBytes + bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!block) return false;
+  offsets_ = static_cast<uint32_t *>(block);
+  arena_ = static_cast<uint8_t *>(block) + tableBytes;
+  capacity_ = bytes;
+  std::fill_n(offsets_, positions_, kNotBuilt);
+  return true;
+}
+
+int16_t RotatedSpriteCache::angleOf(uint16_t position) const {
+  return static_cast<int16_t>(static_cast<uint32_t>(position % positions_) * 3600 / positions_);
+}
+
+void RotatedSpriteCache::draw(Graphics &display, int16_t x, int16_t y, uint16_t position) {
+  position %= positions_;
+  if (offsets_ && offsets_[position] == kNotBuilt && !build(position)) {
+    offsets_[position] = kUncached;
+  }
+  if (!offsets_ || offsets_[position] == kUncached) {
+    drawRotatedSprite(display, sprite_, x, y, angleOf(position));
+    return;
+  }
+
+  const uint8_t *span = arena_ + offsets_[position];
+  const uint16_t count = static_cast<uint16_t>(span[0] | (span[1] << 8));
+  span += 2;
+  SpanBatches batches(display);
+  for (uint16_t i = 0; i < count; ++i, span += kCachedSpanBytes) {
+    batches.add(static_cast<int16_t>(x + static_cast<int8_t>(span[0])),
+                static_cast<int16_t>(x + static_cast<int8_t>(span[1])),
+                static_cast<int16_t>(y + static_cast<int8_t>(span[2])),
+                static_cast<uint16_t>(span[3] | (span[4] << 8)));
+  }
+}
+
+bool RotatedSpriteCache::build(uint16_t position) {
+  if (!sprite_.pixels || sprite_.width == 0 || sprite_.height == 0) return false;
+  const int16_t angle = angleOf(position);
+  const Rect area = rotatedSpriteBounds(sprite_, 0, 0, angle, 0, static_cast<int16_t>(sprite_.width - 1));
+  if (!fitsInt8(area.x, area.x + area.w - 1) || !fitsInt8(area.y, area.y + area.h - 1)) return false;
+  if (capacity_ - used_ < 2) return false;
+
+  // Spans are written in place behind the count and only kept if they
+  // all fit.
+  uint8_t *start = arena_ + used_;
+  uint8_t *out = start + 2;
+  const uint8_t *end = arena_ + capacity_;
+  uint16_t count = 0;
+  bool full = false;
+  rotateRuns(sprite_, 0, 0, angle, area, [&](int16_t a, int16_t b, int16_t row, uint16_t color) {
+    if (full || end - out < static_cast<ptrdiff_t>(kCachedSpanBytes) || count == UINT16_MAX) {
+      full = true;
+      return;
+    }
+    out[0] = static_cast<uint8_t>(a);
+    out[1] = static_cast<uint8_t>(b);
+    out[2] = static_cast<uint8_t>(row);
+    out[3] = static_cast<uint8_t>(color);
+    out[4] = static_cast<uint8_t>(color >> 8);
+    out += kCachedSpanBytes;
+    ++count;
+  });
+  if (full) return false;
+  start[0] = static_cast<uint8_t>(count);
+  start[1] = static_cast<uint8_t>(count >> 8);
+  offsets_[position] = static_cast<uint32_t>(used_);
+  used_ += static_cast<size_t>(out - start);
+  return true;
+}
+
+}  // namespace graphics
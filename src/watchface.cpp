@@ -1,11 +1,34 @@
 #include "watchface.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 
+#include "aa_text.h"
 #include "graphics_utils.h"
 #include "debug_log.h"
+#include "display_manager.h"
+#include "esp_heap_caps.h"
+#include "font_lato14.h"
+#include "gc9a01_graphics.h"
+#include "image_pack.h"
+#include "indexed_canvas.h"
+#include "raster.h"
+#include "recording_graphics.h"
+#include "sprite.h"
+
+#ifndef HACKTOR_DIAL_LAYER
+#define HACKTOR_DIAL_LAYER 1
+#endif
+
+#ifndef HACKTOR_AA_TEXT
+#define HACKTOR_AA_TEXT 1
+#endif
+
+#ifndef HACKTOR_SPRITE_HANDS
+#define HACKTOR_SPRITE_HANDS 1
+#endif
 
 namespace watchface {
 
@@ -17,8 +40,69 @@ inline int32_t mulFixed(int32_t c, int r) {
   return static_cast<int32_t>((c * r) / 10000);
 }
 
+// Inclusive rect in face coordinates.
+struct Rect {
+  int16_t x0;
+  int16_t y0;
+  int16_t x1;
+  int16_t y1;
+};
+
+constexpr Rect kScreenRect = {0, 0, WIDTH - 1, HEIGHT - 1};
+
+inline bool overlaps(const Rect &a, const Rect &b) {
+  return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+// Face rect of a box drawn at (u, v) under RotationScopeCW.
+Rect rotatedBoxCW(int u, int v, int w, int h) {
+  int16_t x0 = static_cast<int16_t>(u);
+  int16_t y0 = static_cast<int16_t>(v);
+  int16_t x1 = static_cast<int16_t>(u + w - 1);
+  int16_t y1 = static_cast<int16_t>(v + h - 1);
+  graphics::rotateRect(x0, y0, x1, y1, 1, WIDTH);
+  return {x0, y0, x1, y1};
+}
+
+// Placement of a label under RotationScopeCW. The box covers the longest
+// label centered where the text goes, so a shorter value clears the
+// previous one in the same single window. Room is reserved in 5x7 cells
+// at textSize whatever the font; curW x curH is the text being shown.
+struct LabelLayout {
+  int boxU;
+  int boxV;
+  int boxW;
+  int boxH;
+  int textU;
+  int textV;
+};
+
+LabelLayout layoutRotatedLabelCW(int centerX, int centerY, int curW, int curH, uint8_t textSize, int maxChars) {
+  const int glyphW = 6 * textSize;
+  const int glyphH = 8 * textSize;
+
+  const int textW_max = maxChars * glyphW;
+  const int textH     = glyphH;
+
+  const int Xtl = centerX - textH / 2;
+  const int Ytl = centerY - textW_max / 2;
+
+  const int u = Ytl;
+  const int v = (WIDTH - 1) - Xtl;
+
+  const int u_text = u + (textH - curW) / 2;
+  const int v_text = v + (textW_max - curH) / 2;
+
+  const int boxW = std::max(textW_max, curW) + 4;
+  const int boxH = curH + 4;
+  const int boxU = u + textH / 2 - boxW / 2;
+
+  return {boxU, v_text - 2, boxW, boxH, u_text, v_text};
+}
+
+template <typename Display>
 void drawRotatedLabelBoxedCW(
-  graphics::Graphics &display,
+  Display &display,
   int centerX, int centerY,
   const char *text,
   uint16_t colorText,
@@ -26,33 +110,46 @@ void drawRotatedLabelBoxedCW(
   uint8_t textSize,
   int maxChars
 ) {
-  const int glyphW = 6 * textSize;
-  const int glyphH = 8 * textSize;
+  const LabelLayout layout = layoutRotatedLabelCW(centerX, centerY, static_cast<int>(std::strlen(text)) * 6 * textSize,
+                                                  8 * textSize, textSize, maxChars);
 
-  const int textW_max = maxChars * glyphW;
-  const int textH     = glyphH;
+  graphics::RotationScopeCW rotation(display);
 
-  const int Xtl = centerX - textH / 2;
-  const int Ytl = centerY - textW_max / 2;
+  display.drawTextBox(layout.boxU, layout.boxV, layout.boxW, layout.boxH,
+                      layout.textU, layout.textV, text, colorText, colorBG, textSize);
+}
 
-  graphics::RotationScopeCW rotation(display);
+// Placement of the battery icon under RotationScopeCW.
+struct BatteryIconLayout {
+  int u;
+  int v;
+  int bodyU;
+  int bodyV;
+  int nubU;
+  int nubV;
+};
+
+BatteryIconLayout layoutRotatedBatteryIconCW(
+  int centerX, int centerY,
+  int reserveW, int reserveH,
+  int bodyW, int bodyH,
+  int nubH
+) {
+  const int Xtl = centerX - reserveH / 2;
+  const int Ytl = centerY - reserveW / 2;
 
   const int u = Ytl;
   const int v = (WIDTH - 1) - Xtl;
 
-  display.fillRect(u - 2, v - 2, textH + 4, textW_max + 4, colorBG);
-
-  const int curW = static_cast<int>(std::strlen(text)) * glyphW;
-  const int curH = glyphH;
-
-  const int u_text = u + (textH - curW) / 2;
-  const int v_text = v + (textW_max - curH) / 2;
+  const int u0 = u + (reserveH - bodyW) / 2;
+  const int v0 = v + (reserveW - bodyH) / 2;
 
-  display.drawText(u_text, v_text, text, colorText, colorBG, textSize);
+  return {u, v, u0, v0, u0 + bodyW, v0 + (bodyH - nubH) / 2};
 }
 
+template <typename Display>
 void drawRotatedBatteryIconBoxedCW(
-  graphics::Graphics &display,
+  Display &display,
   int centerX, int centerY,
   uint16_t colorFG, uint16_t colorBG,
   int reserveW, int reserveH,
@@ -62,27 +159,19 @@ void drawRotatedBatteryIconBoxedCW(
 ) {
   if (levelPercent > 100) levelPercent = 100;
 
-  const int Xtl = centerX - reserveH / 2;
-  const int Ytl = centerY - reserveW / 2;
+  const BatteryIconLayout layout =
+    layoutRotatedBatteryIconCW(centerX, centerY, reserveW, reserveH, bodyW, bodyH, nubH);
 
   graphics::RotationScopeCW rotation(display);
 
-  const int u = Ytl;
-  const int v = (WIDTH - 1) - Xtl;
-
-  display.fillRect(u - 2, v - 2, reserveH + 4, reserveW + 4, colorBG);
-
-  const int u0 = u + (reserveH - bodyW) / 2;
-  const int v0 = v + (reserveW - bodyH) / 2;
+  display.fillRect(layout.u - 2, layout.v - 2, reserveH + 4, reserveW + 4, colorBG);
 
-  display.drawRect(u0, v0, bodyW, bodyH, colorFG);
+  display.drawRect(layout.bodyU, layout.bodyV, bodyW, bodyH, colorFG);
 
-  const int nubX = u0 + bodyW;
-  const int nubY = v0 + (bodyH - nubH) / 2;
-  display.fillRect(nubX, nubY, nubW, nubH, colorFG);
+  display.fillRect(layout.nubU, layout.nubV, nubW, nubH, colorFG);
 
-  const int innerX = u0 + 1;
-  const int innerY = v0 + 1;
+  const int innerX = layout.bodyU + 1;
+  const int innerY = layout.bodyV + 1;
   const int innerW = bodyW - 2;
   const int innerH = bodyH - 2;
 
@@ -94,209 +183,718 @@ void drawRotatedBatteryIconBoxedCW(
   }
 }
 
-void drawStaticFace(
-  graphics::Graphics &display,
-  const tm &currentTime,
-  uint32_t stepsToday,
-  uint8_t batteryPercent
-) {
-  drawDateRotatedCWRightOfCenter(display, currentTime);
-  drawStepsBelowCenter(display, stepsToday);
-  drawBatteryRotatedCWLeftOfCenter(display, batteryPercent);
-  drawTicks(display);
+void tickEnds(int i, int &x1, int &y1, int &x2, int &y2) {
+  const int32_t cx = COS60[i];
+  const int32_t sy = SIN60[i];
+  const int inner = (i % 5 == 0) ? RADIUS - 14 : RADIUS - 6;
+  x1 = CENTER_X + static_cast<int>(mulFixed(cx, inner));
+  y1 = CENTER_Y + static_cast<int>(mulFixed(sy, inner));
+  x2 = CENTER_X + static_cast<int>(mulFixed(cx, RADIUS - 2));
+  y2 = CENTER_Y + static_cast<int>(mulFixed(sy, RADIUS - 2));
 }
 
-}  // namespace
+// Bounding box of a line of the given width, with a pixel to spare for
+// rounding in the rasterizers.
+Rect lineBounds(int x1, int y1, int x2, int y2, uint8_t width) {
+  const int margin = (width + 1) / 2 + 1;
+  return {static_cast<int16_t>(std::min(x1, x2) - margin), static_cast<int16_t>(std::min(y1, y2) - margin),
+          static_cast<int16_t>(std::max(x1, x2) + margin), static_cast<int16_t>(std::max(y1, y2) + margin)};
+}
 
-void init() {
-  for (int i = 0; i < 60; ++i) {
-    double angle = static_cast<double>(i) * 6.0 * DEGREES_TO_RAD;
-    SIN60[i] = static_cast<int16_t>(std::lround(std::sin(angle) * 10000.0));
-    COS60[i] = static_cast<int16_t>(std::lround(std::cos(angle) * 10000.0));
+// Rects waiting to be repainted, merged while that stays cheap.
+class DamageList {
+ public:
+  void add(Rect incoming);
+  void clear() { count_ = 0; }
+  uint8_t count() const { return count_; }
+  const Rect &operator[](uint8_t i) const { return rects_[i]; }
+
+ private:
+  static constexpr uint8_t kMaxRects = 48;
+  // Merging two damaged rects is worth it when the union repaints fewer
+  // extra pixels than this.
+  static constexpr int32_t kMergeSlackPixels = 64;
+
+  Rect rects_[kMaxRects];
+  uint8_t count_ = 0;
+};
+
+void DamageList::add(Rect incoming) {
+  incoming.x0 = std::max<int16_t>(incoming.x0, 0);
+  incoming.y0 = std::max<int16_t>(incoming.y0, 0);
+  incoming.x1 = std::min<int16_t>(incoming.x1, WIDTH - 1);
+  incoming.y1 = std::min<int16_t>(incoming.y1, HEIGHT - 1);
+  if (incoming.x0 > incoming.x1 || incoming.y0 > incoming.y1) return;
+  graphics::addMergedRect<kMergeSlackPixels>(rects_, count_, incoming);
+}
+
+// One element of the retained face. The version changes whenever what the
+// element shows changes.
+//
+// Each widget also has
+//   template <typename Display> void paint(Display &display, const Rect &area) const;
+// which paints it; parts outside `area`, the rect being repainted, may be
+// skipped. It is a template rather than a virtual so that the face draws
+// through the backend's own type: Face knows every widget's type and calls
+// it directly.
+class Widget {
+ public:
+  virtual ~Widget() = default;
+
+  // Rects that together hold every pixel paint() writes.
+  virtual uint8_t cover(Rect *out, uint8_t max) const = 0;
+
+  uint32_t version() const { return version_; }
+
+  bool touches(const Rect &area) const;
+
+ protected:
+  void changed() { ++version_; }
+
+ private:
+  uint32_t version_ = 0;
+};
+
+constexpr uint8_t kMaxCoverRects = 60;
+
+bool Widget::touches(const Rect &area) const {
+  Rect rects[kMaxCoverRects];
+  const uint8_t count = cover(rects, kMaxCoverRects);
+  for (uint8_t i = 0; i < count; ++i) {
+    if (overlaps(rects[i], area)) return true;
   }
+  return false;
 }
 
-void drawTicks(graphics::Graphics &display) {
-  for (int i = 0; i < 60; ++i) {
-    int32_t cx = COS60[i];
-    int32_t sy = SIN60[i];
-
-    if (i % 5 == 0) {
-      int x1 = CENTER_X + static_cast<int>(mulFixed(cx, static_cast<int>(RADIUS - 14)));
-      int y1 = CENTER_Y + static_cast<int>(mulFixed(sy, static_cast<int>(RADIUS - 14)));
-      int x2 = CENTER_X + static_cast<int>(mulFixed(cx, static_cast<int>(RADIUS - 2)));
-      int y2 = CENTER_Y + static_cast<int>(mulFixed(sy, static_cast<int>(RADIUS - 2)));
-
-      float dx = static_cast<float>(x2 - x1);
-      float dy = static_cast<float>(y2 - y1);
-      float len = std::sqrt(dx * dx + dy * dy);
-      float nx = -dy / len;
-      float ny = dx / len;
-      float hw = 2.0f;
-      int x1a = static_cast<int>(std::round(x1 + nx * hw));
-      int y1a = static_cast<int>(std::round(y1 + ny * hw));
-      int x1b = static_cast<int>(std::round(x1 - nx * hw));
-      int y1b = static_cast<int>(std::round(y1 - ny * hw));
-      int x2a = static_cast<int>(std::round(x2 + nx * hw));
-      int y2a = static_cast<int>(std::round(y2 + ny * hw));
-      int x2b = static_cast<int>(std::round(x2 - nx * hw));
-      int y2b = static_cast<int>(std::round(y2 - ny * hw));
-      display.fillTriangle(x1a, y1a, x1b, y1b, x2a, y2a, COLOR_FACE);
-      display.fillTriangle(x2a, y2a, x2b, y2b, x1b, y1b, COLOR_FACE);
+class TickRing : public Widget {
+ public:
+  template <typename Display>
+  void paint(Display &display, const Rect &area) const {
+    // All ticks share a color, so the whole ring goes out as a few batches.
+    graphics::RectBatch batch(display, COLOR_FACE);
+    for (int i = 0; i < 60; ++i) {
+      int x1, y1, x2, y2;
+      tickEnds(i, x1, y1, x2, y2);
+      if (!overlaps(lineBounds(x1, y1, x2, y2, widthOf(i)), area)) continue;
+      if (i % 5 == 0) {
+        graphics::raster::wideLine(x1, y1, x2, y2, MAJOR_TICK_WIDTH, batch);
+      } else {
+        graphics::raster::lineRuns(x1, y1, x2, y2, batch);
+      }
+    }
+  }
+
+  uint8_t cover(Rect *out, uint8_t max) const override {
+    uint8_t count = 0;
+    for (int i = 0; i < 60 && count < max; ++i) {
+      int x1, y1, x2, y2;
+      tickEnds(i, x1, y1, x2, y2);
+      out[count++] = lineBounds(x1, y1, x2, y2, widthOf(i));
+    }
+    return count;
+  }
+
+ private:
+  static uint8_t widthOf(int i) { return i % 5 == 0 ? MAJOR_TICK_WIDTH : 1; }
+};
+
+class Label : public Widget {
+ public:
+  Label(int centerX, int centerY, int maxChars, uint16_t color)
+      : centerX_(centerX), centerY_(centerY), maxChars_(maxChars), color_(color) {
+#if HACKTOR_AA_TEXT
+    run_.font = &kLabelFont;
+    run_.text = text_;
+    run_.setColors(color, COLOR_BG, kLabelShades);
+    placeRun();
+#endif
+  }
+
+  void setText(const char *text) {
+    if (std::strncmp(text_, text, sizeof(text_) - 1) == 0) return;
+    std::snprintf(text_, sizeof(text_), "%s", text);
+#if HACKTOR_AA_TEXT
+    placeRun();
+#endif
+    changed();
+  }
+
+  template <typename Display>
+  void paint(Display &display, const Rect &) const {
+#if HACKTOR_AA_TEXT
+    const LabelLayout layout = this->layout();
+    graphics::RotationScopeCW rotation(display);
+    graphics::drawAaTextBox(display, layout.boxU, layout.boxV, layout.boxW, layout.boxH, run_);
+#else
+    drawRotatedLabelBoxedCW(display, centerX_, centerY_, text_, color_, COLOR_BG, kTextSize, maxChars_);
+#endif
+  }
+
+  uint8_t cover(Rect *out, uint8_t max) const override {
+    if (max == 0) return 0;
+    const LabelLayout layout = this->layout();
+    out[0] = rotatedBoxCW(layout.boxU, layout.boxV, layout.boxW, layout.boxH);
+    return 1;
+  }
+
+ private:
+  static constexpr uint8_t kTextSize = 2;
+#if HACKTOR_AA_TEXT
+  // Sized to the 5x7 glyphs at kTextSize, whose boxes the labels keep. The
+  // 16-color dial layer only has room for a few edge shades per color.
+  static constexpr const graphics::AaFont &kLabelFont = graphics::fonts::kLato14;
+  static constexpr uint8_t kLabelShades = HACKTOR_DIAL_LAYER ? 4 : 16;
+#endif
+
+  LabelLayout layout() const {
+#if HACKTOR_AA_TEXT
+    // The box is as tall as a 5x7 cell, a pixel more than the font, so it
+    // covers the same rects as with HACKTOR_AA_TEXT=0.
+    return layoutRotatedLabelCW(centerX_, centerY_, graphics::aaTextWidth(kLabelFont, text_), 8 * kTextSize,
+                                kTextSize, maxChars_);
+#else
+    return layoutRotatedLabelCW(centerX_, centerY_, static_cast<int>(std::strlen(text_)) * 6 * kTextSize,
+                                8 * kTextSize, kTextSize, maxChars_);
+#endif
+  }
+
+#if HACKTOR_AA_TEXT
+  void placeRun() {
+    const LabelLayout layout = this->layout();
+    run_.x = static_cast<int16_t>(layout.textU);
+    run_.y = static_cast<int16_t>(layout.textV);
+  }
+#endif
+
+  int centerX_;
+  int centerY_;
+  int maxChars_;
+  uint16_t color_;
+  char text_[16] = "";
+#if HACKTOR_AA_TEXT
+  // Read by drawRows when the rows go out, which may be after paint().
+  graphics::AaTextRun run_;
+#endif
+};
+
+class BatteryIcon : public Widget {
+ public:
+  BatteryIcon(int centerX, int centerY) : centerX_(centerX), centerY_(centerY) {}
+
+  void setLevel(uint8_t percent) {
+    if (percent == level_) return;
+    level_ = percent;
+    changed();
+  }
+
+  template <typename Display>
+  void paint(Display &display, const Rect &) const {
+    drawRotatedBatteryIconBoxedCW(
+      display,
+      centerX_, centerY_,
+      COLOR_FACE, COLOR_BG,
+      kReserveW, kReserveH,
+      kBodyW, kBodyH, kNubW, kNubH,
+      level_
+    );
+  }
+
+  uint8_t cover(Rect *out, uint8_t max) const override {
+    if (max == 0) return 0;
+    const BatteryIconLayout layout =
+      layoutRotatedBatteryIconCW(centerX_, centerY_, kReserveW, kReserveH, kBodyW, kBodyH, kNubH);
+    // The nub pokes out of the reserved box.
+    const int u0 = std::min(layout.u - 2, layout.bodyU);
+    const int v0 = std::min(layout.v - 2, layout.bodyV);
+    const int u1 = std::max(layout.u - 2 + kReserveH + 4, layout.nubU + kNubW);
+    const int v1 = std::max(layout.v - 2 + kReserveW + 4, layout.bodyV + kBodyH);
+    out[0] = rotatedBoxCW(u0, v0, u1 - u0, v1 - v0);
+    return 1;
+  }
+
+ private:
+  static constexpr int kReserveW = 24;
+  static constexpr int kReserveH = 16;
+  static constexpr int kBodyW    = 20;
+  static constexpr int kBodyH    = 10;
+  static constexpr int kNubW     = 3;
+  static constexpr int kNubH     = 4;
+
+  int centerX_;
+  int centerY_;
+  uint8_t level_ = 0;
+};
+
+// Hand positions around the dial, one per SIN60/COS60 entry.
+constexpr uint16_t kHandPositions = 60;
+
+// A line from the hub to a tip, optionally continued past the hub to a
+// tail, drawn as one polyline. Its cover follows the line in short pieces,
+// so moving it damages little more than the pixels it actually hides. A
+// hand given a sprite draws that instead, turned to its position.
+class Hand : public Widget {
+ public:
+  Hand(uint8_t width, uint16_t color) : width_(width), color_(color) {}
+
+  // Draws the sprite in place of the line from now on, turned to the hand's
+  // position out of kHandPositions.
+  void setSprite(graphics::RotatedSpriteCache *sprite) {
+    sprite_ = sprite;
+    updateSpriteCover();
+    changed();
+  }
+
+  void setPosition(uint16_t position) {
+    if (position == position_) return;
+    position_ = position;
+    updateSpriteCover();
+    changed();
+  }
+
+  void setTip(int x, int y) {
+    if (x == tipX_ && y == tipY_) return;
+    tipX_ = x;
+    tipY_ = y;
+    changed();
+  }
+
+  void setTail(int x, int y) {
+    if (x == tailX_ && y == tailY_) return;
+    tailX_ = x;
+    tailY_ = y;
+    changed();
+  }
+
+  template <typename Display>
+  void paint(Display &display, const Rect &) const {
+    if (sprite_) {
+      sprite_->draw(display, CENTER_X, CENTER_Y, position_);
+      return;
+    }
+    const graphics::Point points[3] = {
+      {static_cast<int16_t>(tailX_), static_cast<int16_t>(tailY_)},
+      {CENTER_X, CENTER_Y},
+      {static_cast<int16_t>(tipX_), static_cast<int16_t>(tipY_)},
+    };
+    display.drawPolyline(hasTail() ? points : points + 1, hasTail() ? 3 : 2, width_, color_);
+  }
+
+  uint8_t cover(Rect *out, uint8_t max) const override {
+    if (sprite_) {
+      const uint8_t count = std::min(spriteCoverCount_, max);
+      std::copy(spriteCover_, spriteCover_ + count, out);
+      return count;
+    }
+    uint8_t count = coverSegment(tipX_, tipY_, out, max);
+    if (hasTail()) {
+      count = static_cast<uint8_t>(count + coverSegment(tailX_, tailY_, out + count, max - count));
+    }
+    return count;
+  }
+
+ private:
+  static constexpr int kPiecePixels = 12;
+  static constexpr uint8_t kMaxSpritePieces = 20;
+
+  bool hasTail() const { return tailX_ != CENTER_X || tailY_ != CENTER_Y; }
+
+  uint8_t coverSegment(int endX, int endY, Rect *out, uint8_t max) const {
+    const int dx = endX - CENTER_X;
+    const int dy = endY - CENTER_Y;
+    const int length = std::max(std::abs(dx), std::abs(dy));
+    const int pieces = std::min<int>(max, std::max(1, (length + kPiecePixels - 1) / kPiecePixels));
+    int x1 = CENTER_X;
+    int y1 = CENTER_Y;
+    for (int i = 1; i <= pieces; ++i) {
+      const int x2 = CENTER_X + dx * i / pieces;
+      const int y2 = CENTER_Y + dy * i / pieces;
+      out[i - 1] = lineBounds(x1, y1, x2, y2, width_);
+      x1 = x2;
+      y1 = y2;
+    }
+    return static_cast<uint8_t>(pieces);
+  }
+
+  // The turned sprite cut across its length, so a diagonal hand is not
+  // covered by one large square. Transparent columns at either end are
+  // left out. Kept from one move to the next, as cover() runs for every
+  // damaged rect.
+  void updateSpriteCover() {
+    spriteCoverCount_ = 0;
+    if (!sprite_) return;
+    const graphics::Sprite &sprite = sprite_->sprite();
+    const int16_t angle = sprite_->angleOf(position_);
+    const int first = sprite_->firstOpaqueColumn();
+    const int columns = sprite_->lastOpaqueColumn() - first + 1;
+    if (columns <= 0) return;
+    const int pieces = std::min<int>(kMaxSpritePieces, (columns + kPiecePixels - 1) / kPiecePixels);
+    for (int i = 0; i < pieces; ++i) {
+      const int16_t u0 = static_cast<int16_t>(first + columns * i / pieces);
+      const int16_t u1 = static_cast<int16_t>(first + columns * (i + 1) / pieces - 1);
+      const graphics::Rect r = graphics::rotatedSpriteBounds(sprite, CENTER_X, CENTER_Y, angle, u0, u1);
+      spriteCover_[i] = {r.x, r.y, static_cast<int16_t>(r.x + r.w - 1), static_cast<int16_t>(r.y + r.h - 1)};
+    }
+    spriteCoverCount_ = static_cast<uint8_t>(pieces);
+  }
+
+  uint8_t width_;
+  uint16_t color_;
+  int tipX_ = CENTER_X;
+  int tipY_ = CENTER_Y;
+  int tailX_ = CENTER_X;
+  int tailY_ = CENTER_Y;
+  graphics::RotatedSpriteCache *sprite_ = nullptr;
+  uint16_t position_ = 0;
+  Rect spriteCover_[kMaxSpritePieces];
+  uint8_t spriteCoverCount_ = 0;
+};
+
+// Hand images come from the image pack, named hand_hour, hand_minute and
+// hand_second. They point right, toward position 0 (12 o'clock), turn about their
+// center, and COLOR_BG pixels are left out, so images converted over the
+// default black background blend into the dial. Without them the hands
+// stay lines.
+class SpriteHand {
+ public:
+  SpriteHand() = default;
+  SpriteHand(const SpriteHand &) = delete;
+  SpriteHand &operator=(const SpriteHand &) = delete;
+
+  ~SpriteHand() { heap_caps_free(pixels_); }
+
+  bool load(const char *name, Hand &hand) {
+    image_pack::Image image;
+    if (pixels_ || !image_pack::find(name, image)) return false;
+    const size_t bytes = static_cast<size_t>(image.width) * image.height * sizeof(uint16_t);
+    pixels_ = static_cast<uint16_t *>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!pixels_) {
+      pixels_ = static_cast<uint16_t *>(heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    }
+    if (!pixels_) return false;
+    image_pack::unpack(image, pixels_);
+
+    graphics::Sprite sprite;
+    sprite.pixels = pixels_;
+    sprite.width = image.width;
+    sprite.height = image.height;
+    sprite.key = COLOR_BG;
+    sprite.pivotX = static_cast<int16_t>(image.width / 2);
+    sprite.pivotY = static_cast<int16_t>(image.height / 2);
+    if (!cache_.begin(sprite, kHandPositions, kCacheBytes)) {
+      LOG_PRINTF(1, "[display] %s rotated on every draw\n", name);
+    }
+    hand.setSprite(&cache_);
+    return true;
+  }
+
+ private:
+  // Roughly what 60 positions of a 100 px hand take.
+  static constexpr size_t kCacheBytes = 48 * 1024;
+
+  uint16_t *pixels_ = nullptr;
+  graphics::RotatedSpriteCache cache_;
+};
+
+class Hub : public Widget {
+ public:
+  template <typename Display>
+  void paint(Display &display, const Rect &) const {
+    display.fillCircle(CENTER_X, CENTER_Y, 6, COLOR_FACE);
+    display.fillCircle(CENTER_X, CENTER_Y, 3, COLOR_SEC_HAND);
+  }
+
+  uint8_t cover(Rect *out, uint8_t max) const override {
+    if (max == 0) return 0;
+    out[0] = {CENTER_X - 6, CENTER_Y - 6, CENTER_X + 6, CENTER_Y + 6};
+    return 1;
+  }
+};
+
+// Date sits right of center, battery left of it; both read top to bottom.
+constexpr int kTextSize = 2;
+constexpr int kGlyphW = 6 * kTextSize;
+constexpr int kDateX = CENTER_X + 25;
+constexpr int kDateTop = CENTER_Y + 75 - (3 * kGlyphW + kGlyphW + 2 * kGlyphW) / 2;
+constexpr int kBatteryX = CENTER_X + 25;
+constexpr int kBatteryTop = CENTER_Y - 40 - (24 + kGlyphW + 3 * kGlyphW + kGlyphW + kGlyphW) / 2;
+
+class Face {
+ public:
+  Face()
+      : week_(kDateX, kDateTop + 3 * kGlyphW / 2, 3, COLOR_FACE),
+        day_(kDateX - 6, kDateTop + 3 * kGlyphW + kGlyphW + 2 * kGlyphW / 2 - 15, 2, COLOR_DATE_NUM),
+        steps_(CENTER_X - 25, CENTER_Y + 30, 6, COLOR_STEPS),
+        battery_(kBatteryX - 5, kBatteryTop + 12 - 4),
+        batteryNumber_(kBatteryX, kBatteryTop + 24 + kGlyphW + 3 * kGlyphW / 2 - 7, 3, COLOR_FACE),
+        batteryPercent_(kBatteryX - 12, kBatteryTop + 24 + kGlyphW + 3 * kGlyphW + kGlyphW + kGlyphW / 2 - 27,
+                        1, COLOR_DATE_NUM),
+        hour_(HAND_WIDTH, COLOR_HOUR_HAND),
+        minute_(HAND_WIDTH, COLOR_MIN_HAND),
+        second_(1, COLOR_SEC_HAND),
+        dialLayer_(kDialLayerBits) {
+    batteryPercent_.setText("%");
+  }
+
+  // Renders the dial into its own layer once; without the memory for it
+  // every repaint starts from the background instead.
+  void begin() {
+#if HACKTOR_SPRITE_HANDS
+    hourSprite_.load("hand_hour", hour_);
+    minuteSprite_.load("hand_minute", minute_);
+    secondSprite_.load("hand_second", second_);
+#endif
+#if HACKTOR_DIAL_LAYER
+    if (layered_) return;
+    if (!dialLayer_.begin()) {
+      LOG_PRINT(1, "[display] no memory for the dial layer");
+      return;
+    }
+    layered_ = true;
+    dialLayer_.fillScreen(COLOR_BG);
+    paintWidgets(dialLayer_, kScreenRect, 0, kDialWidgets);
+#endif
+  }
+
+  void update(const tm &currentTime, uint32_t stepsToday, uint8_t batteryPercent) {
+    static const char *WNAME[] = {"SUN","MON","TUE","WED","THU","FRI","SAT"};
+    char buf[16];
+
+    // Dial changes are first redrawn into the layer, then restored on screen.
+    DamageList &dialDamage = layered_ ? dialDamage_ : damage_;
+    retain(week_, dialDamage, [&] { week_.setText(WNAME[currentTime.tm_wday % 7]); });
+    std::snprintf(buf, sizeof(buf), "%02d", currentTime.tm_mday);
+    retain(day_, dialDamage, [&] { day_.setText(buf); });
+    std::snprintf(buf, sizeof(buf), "%lu", static_cast<unsigned long>(stepsToday));
+    retain(steps_, dialDamage, [&] { steps_.setText(buf); });
+    retain(battery_, dialDamage, [&] { battery_.setLevel(batteryPercent); });
+    std::snprintf(buf, sizeof(buf), "%u", static_cast<unsigned>(batteryPercent));
+    retain(batteryNumber_, dialDamage, [&] { batteryNumber_.setText(buf); });
+
+    int hx, hy, mx, my, sx, sy, tx, ty;
+    calcHourEnd(currentTime, hx, hy);
+    calcMinuteEnd(currentTime, mx, my);
+    calcSecondEnds(currentTime, sx, sy, tx, ty);
+    retain(hour_, damage_, [&] {
+      hour_.setTip(hx, hy);
+      hour_.setPosition(static_cast<uint16_t>((currentTime.tm_hour % 12) * 5 + currentTime.tm_min / 12));
+    });
+    retain(minute_, damage_, [&] {
+      minute_.setTip(mx, my);
+      minute_.setPosition(static_cast<uint16_t>(currentTime.tm_min % 60));
+    });
+    retain(second_, damage_, [&] {
+      second_.setPosition(static_cast<uint16_t>(currentTime.tm_sec % 60));
+      second_.setTip(sx, sy);
+      second_.setTail(tx, ty);
+    });
+
+    if (layered_) {
+      for (uint8_t i = 0; i < dialDamage_.count(); ++i) {
+        const Rect &area = dialDamage_[i];
+        graphics::ClipScope clip(dialLayer_, area.x0, area.y0, area.x1, area.y1);
+        dialLayer_.fillScreen(COLOR_BG);
+        paintWidgets(dialLayer_, area, 0, kDialWidgets);
+        damage_.add(area);
+      }
+      dialDamage_.clear();
+    }
+  }
+
+  void beginFrame(bool full) {
+    full_ = full;
+    step_ = 0;
+  }
+
+  template <typename Display>
+  bool drawStep(Display &display) {
+    if (full_) {
+      // The base, then one widget per step.
+      if (step_ == 0) {
+        paintBase(display, kScreenRect);
+      } else {
+        const uint8_t widget = static_cast<uint8_t>(firstOnTop() + step_ - 1);
+        paintWidgets(display, kScreenRect, widget, widget + 1);
+      }
+      ++step_;
+      if (firstOnTop() + step_ - 1 < kWidgetCount) return true;
+    } else if (step_ < damage_.count()) {
+      // Each damaged rect is rebuilt from the bottom up, painting only the
+      // widgets that reach into it, in the same order as a full paint.
+      const Rect &area = damage_[step_++];
+      {
+        graphics::ClipScope clip(display, area.x0, area.y0, area.x1, area.y1);
+        paintBase(display, area);
+        paintWidgets(display, area, firstOnTop(), kWidgetCount);
+      }
+      if (step_ < damage_.count()) return true;
+    }
+    damage_.clear();
+    return false;
+  }
+
+ private:
+  static constexpr uint8_t kWidgetCount = 11;
+  // Widgets before this index belong to the dial and live in the layer.
+  static constexpr uint8_t kDialWidgets = 7;
+  // The dial uses seven colors: black, white and red, plus the two edge
+  // shades each label ramp adds between black and its color. 16 palette
+  // entries leave room to spare.
+  static constexpr uint8_t kDialLayerBits = 4;
+
+  uint8_t firstOnTop() const { return layered_ ? kDialWidgets : 0; }
+
+  // What lies under the widgets drawn on top: the dial layer, or just the
+  // background.
+  template <typename Display>
+  void paintBase(Display &display, const Rect &area) {
+    if (layered_) {
+      display.drawRows(area.x0, area.y0, area.x1 - area.x0 + 1, area.y1 - area.y0 + 1,
+                       graphics::IndexedCanvas::readRow, &dialLayer_);
     } else {
-      int x1 = CENTER_X + static_cast<int>(mulFixed(cx, static_cast<int>(RADIUS - 6)));
-      int y1 = CENTER_Y + static_cast<int>(mulFixed(sy, static_cast<int>(RADIUS - 6)));
-      int x2 = CENTER_X + static_cast<int>(mulFixed(cx, static_cast<int>(RADIUS - 2)));
-      int y2 = CENTER_Y + static_cast<int>(mulFixed(sy, static_cast<int>(RADIUS - 2)));
-      display.drawLine(x1, y1, x2, y2, COLOR_FACE);
+      display.fillRect(area.x0, area.y0, area.x1 - area.x0 + 1, area.y1 - area.y0 + 1, COLOR_BG);
     }
   }
-}
 
-void drawDateRotatedCWRightOfCenter(graphics::Graphics &display, const tm &currentTime) {
-  static const char *WNAME[] = {"SUN","MON","TUE","WED","THU","FRI","SAT"};
-  char weekStr[4];
-  std::snprintf(weekStr, sizeof(weekStr), "%s", WNAME[currentTime.tm_wday]);
-  char dayStr[3];
-  std::snprintf(dayStr, sizeof(dayStr), "%02d", currentTime.tm_mday);
-
-  const uint8_t txtSize = 2;
-  const int glyphW = 6 * txtSize;
-  const int w_week  = 3 * glyphW;
-  const int w_space = 1 * glyphW;
-  const int w_day   = 2 * glyphW;
-  const int totalW  = w_week + w_space + w_day;
-
-  const int Xc = CENTER_X + 25;
-  const int Yc = CENTER_Y + 75;
-
-  const int week_centerY = Yc - (totalW / 2) + (w_week / 2);
-  const int day_centerY  = Yc - (totalW / 2) + w_week + w_space + (w_day / 2);
-
-  drawRotatedLabelBoxedCW(
-    display,
-    Xc, week_centerY,
-    weekStr, COLOR_FACE, COLOR_BG,
-    txtSize,
-    3
-  );
-
-  drawRotatedLabelBoxedCW(
-    display,
-    Xc - 6, day_centerY - 15,
-    dayStr, COLOR_DATE_NUM, COLOR_BG,
-    txtSize,
-    2
-  );
-}
+  template <typename Display>
+  void paintWidgets(Display &display, const Rect &area, uint8_t first, uint8_t last) const {
+    forEachWidget([&](uint8_t i, const auto &widget) {
+      if (i >= first && i < last && widget.touches(area)) {
+        widget.paint(display, area);
+      }
+    });
+  }
 
-void drawStepsBelowCenter(graphics::Graphics &display, uint32_t stepsToday) {
-  char buf[16];
-  std::snprintf(buf, sizeof(buf), "%lu", static_cast<unsigned long>(stepsToday));
-  drawRotatedLabelBoxedCW(display, CENTER_X - 25, CENTER_Y + 30, buf, COLOR_STEPS, COLOR_BG, 2, 6);
-}
+  // Calls `visit` with the index and the widget, in paint order, back to
+  // front.
+  template <typename Visit>
+  void forEachWidget(Visit &&visit) const {
+    uint8_t i = 0;
+    visit(i++, week_);
+    visit(i++, day_);
+    visit(i++, steps_);
+    visit(i++, battery_);
+    visit(i++, batteryNumber_);
+    visit(i++, batteryPercent_);
+    visit(i++, ticks_);
+    visit(i++, hour_);
+    visit(i++, minute_);
+    visit(i++, second_);
+    visit(i++, hub_);
+  }
+
+  // Runs `apply` on `widget`; if its version moved, both where it was and
+  // where it is now need repainting.
+  template <typename Apply>
+  void retain(Widget &widget, DamageList &damage, Apply &&apply) {
+    Rect before[kMaxCoverRects];
+    const uint8_t beforeCount = widget.cover(before, kMaxCoverRects);
+    const uint32_t version = widget.version();
+    apply();
+    if (widget.version() == version) return;
+    for (uint8_t i = 0; i < beforeCount; ++i) {
+      damage.add(before[i]);
+    }
+    Rect after[kMaxCoverRects];
+    const uint8_t afterCount = widget.cover(after, kMaxCoverRects);
+    for (uint8_t i = 0; i < afterCount; ++i) {
+      damage.add(after[i]);
+    }
+  }
+
+  TickRing ticks_;
+  Label week_;
+  Label day_;
+  Label steps_;
+  BatteryIcon battery_;
+  Label batteryNumber_;
+  Label batteryPercent_;
+  Hand hour_;
+  Hand minute_;
+  Hand second_;
+  Hub hub_;
+  SpriteHand hourSprite_;
+  SpriteHand minuteSprite_;
+  SpriteHand secondSprite_;
+
+  DamageList damage_;
+  // Frame being painted by drawStep() and the next step of it.
+  bool full_ = false;
+  uint8_t step_ = 0;
+
+  // Dial as last rendered, read back wherever a hand moves off it.
+  graphics::IndexedCanvas dialLayer_;
+  bool layered_ = false;
+  DamageList dialDamage_;
+};
+
+Face face;
+
+}  // namespace
 
-void drawBatteryRotatedCWLeftOfCenter(graphics::Graphics &display, uint8_t batteryPercent) {
-  char numStr[4];
-  std::snprintf(numStr, sizeof(numStr), "%u", static_cast<unsigned>(batteryPercent));
-  const char *pctStr = "%";
-
-  const uint8_t txtSize = 2;
-  const int glyphW = 6 * txtSize;
-  const int w_num_max = 3 * glyphW;
-  const int w_space   = 1 * glyphW;
-  const int w_pct     = 1 * glyphW;
-
-  const int iconReserveW = 24;
-  const int iconReserveH = 16;
-  const int bodyW        = 20;
-  const int bodyH        = 10;
-  const int nubW         = 3;
-  const int nubH         = 4;
-
-  const int totalW = iconReserveW + w_space + w_num_max + w_space + w_pct;
-
-  const int Xc = CENTER_X + 25;
-  const int Yc = CENTER_Y - 40;
-
-  int cursor = Yc - (totalW / 2);
-
-  const int icon_centerY = cursor + iconReserveW / 2;
-  cursor += iconReserveW + w_space;
-
-  const int num_centerY  = cursor + w_num_max / 2;
-  cursor += w_num_max + w_space;
-
-  const int pct_centerY  = cursor + w_pct / 2;
-
-  drawRotatedBatteryIconBoxedCW(
-    display,
-    Xc - 5, icon_centerY - 4,
-    COLOR_FACE, COLOR_BG,
-    iconReserveW, iconReserveH,
-    bodyW, bodyH, nubW, nubH,
-    batteryPercent
-  );
-
-  drawRotatedLabelBoxedCW(
-    display,
-    Xc, num_centerY - 7,
-    numStr, COLOR_FACE, COLOR_BG,
-    txtSize, 3
-  );
-
-  drawRotatedLabelBoxedCW(
-    display,
-    Xc - 12, pct_centerY - 27,
-    pctStr, COLOR_DATE_NUM, COLOR_BG,
-    txtSize, 1
-  );
+void init() {
+  for (int i = 0; i < 60; ++i) {
+    double angle = static_cast<double>(i) * 6.0 * DEGREES_TO_RAD;
+    SIN60[i] = static_cast<int16_t>(std::lround(std::sin(angle) * 10000.0));
+    COS60[i] = static_cast<int16_t>(std::lround(std::cos(angle) * 10000.0));
+  }
+  face.begin();
 }
 
-void drawThick3Line(graphics::Graphics &display, int x0, int y0, int x1, int y1, uint16_t color) {
-  display.drawLine(x0, y0, x1, y1, color);
-  display.drawLine(x0 - 1, y0 - 1, x1 - 1, y1 - 1, color);
-  display.drawLine(x0 + 1, y0 + 1, x1 + 1, y1 + 1, color);
+void update(const tm &currentTime, uint32_t stepsToday, uint8_t batteryPercent) {
+  face.update(currentTime, stepsToday, batteryPercent);
 }
 
-void drawFullFaceAndHands(
-  graphics::Graphics &display,
-  const tm &currentTime,
-  uint32_t stepsToday,
-  uint8_t batteryPercent,
-  int &prev_hx, int &prev_hy,
-  int &prev_mx, int &prev_my,
-  int &prev_sx, int &prev_sy,
-  int &prev_stx, int &prev_sty
-) {
+template <typename Display>
+void drawFull(Display &display) {
 #if HACKTOR_DEBUG_LEVEL >= 1
   uint32_t startUs = micros();
+  const graphics::TransferStats startStats = display_manager::transferStats();
 #endif
-  display.fillScreen(COLOR_BG);
-  drawStaticFace(display, currentTime, stepsToday, batteryPercent);
-
-  int hx, hy, mx, my, sx, sy, tx, ty;
-  calcHourEnd(currentTime, hx, hy);
-  calcMinuteEnd(currentTime, mx, my);
-  calcSecondEnds(currentTime, sx, sy, tx, ty);
-
-  drawThick3Line(display, CENTER_X, CENTER_Y, hx, hy, COLOR_HOUR_HAND);
-  drawThick3Line(display, CENTER_X, CENTER_Y, mx, my, COLOR_MIN_HAND);
-  display.drawLine(CENTER_X, CENTER_Y, sx, sy, COLOR_SEC_HAND);
-  display.drawLine(CENTER_X, CENTER_Y, tx, ty, COLOR_SEC_HAND);
-  display.fillCircle(CENTER_X, CENTER_Y, 6, COLOR_FACE);
-  display.fillCircle(CENTER_X, CENTER_Y, 3, COLOR_SEC_HAND);
-
-  prev_hx = hx; prev_hy = hy;
-  prev_mx = mx; prev_my = my;
-  prev_sx = sx; prev_sy = sy;
-  prev_stx = tx; prev_sty = ty;
+  face.beginFrame(true);
+  while (face.drawStep(display)) {
+  }
 #if HACKTOR_DEBUG_LEVEL >= 1
   uint32_t elapsedUs = micros() - startUs;
-  LOG_PRINTF(1, "[display] full face %lu us\n", static_cast<unsigned long>(elapsedUs));
+  const graphics::TransferStats endStats = display_manager::transferStats();
+  LOG_PRINTF(1, "[display] full face %lu us, %lu B queued in %lu windows\n",
+             static_cast<unsigned long>(elapsedUs),
+             static_cast<unsigned long>(endStats.bytes - startStats.bytes),
+             static_cast<unsigned long>(endStats.windows - startStats.windows));
 #endif
 }
 
+template <typename Display>
+void drawDamage(Display &display) {
+  face.beginFrame(false);
+  while (face.drawStep(display)) {
+  }
+}
+
+void beginFrame(bool full) {
+  face.beginFrame(full);
+}
+
+template <typename Display>
+bool drawStep(Display &display) {
+  return face.drawStep(display);
+}
+
+template void drawFull(graphics::Graphics &);
+template void drawDamage(graphics::Graphics &);
+template bool drawStep(graphics::Graphics &);
+
+template void drawFull(graphics::Gc9a01Graphics &);
+template void drawDamage(graphics::Gc9a01Graphics &);
+template bool drawStep(graphics::Gc9a01Graphics &);
+
+template void drawFull(graphics::RecordingGraphics &);
+template void drawDamage(graphics::RecordingGraphics &);
+template bool drawStep(graphics::RecordingGraphics &);
+
+template void drawFull(graphics::IndexedCanvas &);
+template void drawDamage(graphics::IndexedCanvas &);
+template bool drawStep(graphics::IndexedCanvas &);
+
 void calcHourEnd(const tm &currentTime, int &hx, int &hy) {
   int index = ((currentTime.tm_hour % 12) * 5) + (currentTime.tm_min / 12);
   int32_t cx = COS60[index];
@@ -0,0 +1,36 @@
+#pragma once
+
+// Just enough of the Arduino core for the display sources to build on the
+// host. Timing is the host clock; pin calls do nothing.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define INPUT 0
+#define INPUT_PULLUP 2
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+unsigned long millis();
+unsigned long micros();
+
+struct HardwareSerial {
+  void begin(unsigned long baud);
+  void println(const char *text);
+  int printf(const char *format, ...);
+};
+
+extern HardwareSerial Serial;
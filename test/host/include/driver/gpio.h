@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+typedef int gpio_num_t;
+typedef enum { GPIO_MODE_OUTPUT = 2 } gpio_mode_t;
+
+struct gpio_config_t {
+  uint64_t pin_bit_mask;
+  gpio_mode_t mode;
+  int pull_up_en;
+  int pull_down_en;
+  int intr_type;
+};
+
+int gpio_config(const gpio_config_t *config);
+// The simulated panel takes any pin's level as its DC line.
+int gpio_set_level(gpio_num_t pin, uint32_t level);
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// The write-1-to-set/clear registers the driver toggles DC through. Only
+// the DC pin's bit reaches the simulated panel.
+struct GpioW1Reg {
+  bool set;
+  bool high;
+  GpioW1Reg &operator=(uint32_t mask);
+};
+
+struct GpioW1Bank {
+  GpioW1Reg val;
+};
+
+struct gpio_dev_t {
+  GpioW1Reg out_w1ts{true, false};
+  GpioW1Reg out_w1tc{false, false};
+  GpioW1Bank out1_w1ts{{true, true}};
+  GpioW1Bank out1_w1tc{{false, true}};
+};
+
+extern gpio_dev_t GPIO;
@@ -0,0 +1,273 @@
+#include "sim.h"
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "hardware_pins.h"
+#include "soc/gpio_struct.h"
+
+namespace sim {
+
+uint16_t panel[kPanelSize * kPanelSize];
+uint32_t commands = 0;
+
+namespace {
+
+bool dcHigh = true;
+uint8_t command = 0;
+std::vector<uint8_t> args;
+uint8_t madctl = 0;
+uint8_t colmod = 0x05;
+int columnStart = 0, columnEnd = kPanelSize - 1;
+int rowStart = 0, rowEnd = kPanelSize - 1;
+int writeX = 0, writeY = 0;
+bool haveHighByte = false;
+uint8_t highByte = 0;
+// RGB444 channels waiting for the rest of their pixel.
+uint8_t nibbles[3];
+int nibbleCount = 0;
+
+const uint8_t *partitionData = nullptr;
+esp_partition_t partition{};
+bool psram = false;
+
+void putPixel(uint16_t color) {
+  int x = writeX;
+  int y = writeY;
+  // MV, MX and MY as the GC9A01 applies them to the write pointer.
+  if (madctl & 0x20) std::swap(x, y);
+  if (madctl & 0x40) x = kPanelSize - 1 - x;
+  if (madctl & 0x80) y = kPanelSize - 1 - y;
+  if (x >= 0 && x < kPanelSize && y >= 0 && y < kPanelSize) panel[y * kPanelSize + x] = color;
+  if (++writeX > columnEnd) {
+    writeX = columnStart;
+    ++writeY;
+  }
+}
+
+void putNibble(uint8_t value) {
+  nibbles[nibbleCount++] = value;
+  if (nibbleCount < 3) return;
+  nibbleCount = 0;
+  const int r = nibbles[0], g = nibbles[1], b = nibbles[2];
+  putPixel(static_cast<uint16_t>((((r << 1) | (r >> 3)) << 11) | (((g << 2) | (g >> 2)) << 5) | ((b << 1) | (b >> 3))));
+}
+
+void commandByte(uint8_t value) {
+  command = value;
+  args.clear();
+  haveHighByte = false;
+  nibbleCount = 0;
+  ++commands;
+  if (value == 0x2C) {
+    writeX = columnStart;
+    writeY = rowStart;
+  }
+}
+
+void dataByte(uint8_t value) {
+  if (command == 0x2C || command == 0x3C) {
+    if (colmod == 0x03) {
+      putNibble(value >> 4);
+      putNibble(value & 0x0F);
+    } else if (!haveHighByte) {
+      highByte = value;
+      haveHighByte = true;
+    } else {
+      haveHighByte = false;
+      putPixel(static_cast<uint16_t>((highByte << 8) | value));
+    }
+    return;
+  }
+  args.push_back(value);
+  if (command == 0x2A && args.size() == 4) {
+    columnStart = (args[0] << 8) | args[1];
+    columnEnd = (args[2] << 8) | args[3];
+  } else if (command == 0x2B && args.size() == 4) {
+    rowStart = (args[0] << 8) | args[1];
+    rowEnd = (args[2] << 8) | args[3];
+  } else if (command == 0x36 && args.size() == 1) {
+    madctl = value;
+  } else if (command == 0x3A && args.size() == 1) {
+    colmod = value;
+  }
+}
+
+}  // namespace
+
+void reset() {
+  std::fill_n(panel, kPanelSize * kPanelSize, 0);
+  commands = 0;
+}
+
+bool visible(int x, int y) {
+  const int dx = 2 * x + 1 - kPanelSize;
+  const int dy = 2 * y + 1 - kPanelSize;
+  return dx * dx + dy * dy <= kPanelSize * kPanelSize;
+}
+
+void setImagePartition(const uint8_t *data, size_t size) {
+  partitionData = data;
+  partition = {};
+  partition.type = ESP_PARTITION_TYPE_DATA;
+  partition.size = static_cast<uint32_t>(size);
+}
+
+void setPsramAvailable(bool available) {
+  psram = available;
+}
+
+void setDc(bool high) {
+  dcHigh = high;
+}
+
+void transmit(const spi_transaction_t *trans) {
+  const uint8_t *bytes = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data
+                                                                : static_cast<const uint8_t *>(trans->tx_buffer);
+  for (size_t i = 0; i < trans->length / 8; ++i) {
+    if (dcHigh) {
+      dataByte(bytes[i]);
+    } else {
+      commandByte(bytes[i]);
+    }
+  }
+}
+
+}  // namespace sim
+
+// Arduino core.
+
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long) {}
+void HardwareSerial::println(const char *) {}
+int HardwareSerial::printf(const char *, ...) { return 0; }
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return 0; }
+// Reset and init waits are real time on the panel and mean nothing here.
+void delay(uint32_t) {}
+void delayMicroseconds(uint32_t) {}
+
+unsigned long micros() {
+  static const auto start = std::chrono::steady_clock::now();
+  return static_cast<unsigned long>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+unsigned long millis() {
+  return micros() / 1000;
+}
+
+// Heap.
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+  if ((caps & MALLOC_CAP_SPIRAM) && !sim::psram) return nullptr;
+  return std::malloc(size);
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+  if ((caps & MALLOC_CAP_SPIRAM) && !sim::psram) return nullptr;
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void heap_caps_free(void *ptr) {
+  std::free(ptr);
+}
+
+// GPIO. The driver sets DC through the W1TS/W1TC registers, the bus through
+// gpio_set_level.
+
+gpio_dev_t GPIO;
+
+GpioW1Reg &GpioW1Reg::operator=(uint32_t mask) {
+  const int dc = pins::LCD_DC;
+  if (high == (dc >= 32) && (mask & (1u << (dc % 32)))) sim::setDc(set);
+  return *this;
+}
+
+int gpio_config(const gpio_config_t *) { return ESP_OK; }
+
+int gpio_set_level(gpio_num_t pin, uint32_t level) {
+  if (pin == pins::LCD_DC) sim::setDc(level != 0);
+  return ESP_OK;
+}
+
+// SPI master.
+
+struct spi_device_t {
+  transaction_cb_t pre_cb;
+};
+
+namespace {
+spi_device_t device;
+std::deque<spi_transaction_t *> results;
+
+void run(spi_transaction_t *trans) {
+  if (device.pre_cb) device.pre_cb(trans);
+  sim::transmit(trans);
+}
+}  // namespace
+
+esp_err_t spi_bus_initialize(spi_host_device_t, const spi_bus_config_t *, int) { return ESP_OK; }
+esp_err_t spi_bus_free(spi_host_device_t) { return ESP_OK; }
+
+esp_err_t spi_bus_add_device(spi_host_device_t, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle) {
+  device.pre_cb = config->pre_cb;
+  *handle = &device;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t) { return ESP_OK; }
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t, spi_transaction_t *trans, TickType_t) {
+  run(trans);
+  results.push_back(trans);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t, spi_transaction_t **trans, TickType_t) {
+  if (results.empty()) {
+    // On the target this would block forever.
+    std::fprintf(stderr, "spi_device_get_trans_result with nothing queued\n");
+    std::abort();
+  }
+  *trans = results.front();
+  results.pop_front();
+  return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t, TickType_t) { return ESP_OK; }
+void spi_device_release_bus(spi_device_handle_t) {}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t, spi_transaction_t *trans) {
+  run(trans);
+  return ESP_OK;
+}
+
+// Partitions.
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char *) {
+  return sim::partitionData ? &sim::partition : nullptr;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *part, size_t offset, size_t size, esp_partition_mmap_memory_t,
+                             const void **out_ptr, esp_partition_mmap_handle_t *out_handle) {
+  if (!sim::partitionData || offset + size > part->size) return ESP_FAIL;
+  *out_ptr = sim::partitionData + offset;
+  *out_handle = 1;
+  return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t) {}
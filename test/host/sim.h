@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Host model of the display hardware for the native tests: the SPI master
+// runs each transaction straight into a GC9A01 that decodes commands, the
+// address window, MADCTL and both pixel formats into `panel`. The rest of
+// the ESP-IDF and Arduino surface the display sources use is stubbed in
+// include/.
+
+namespace sim {
+
+constexpr int kPanelSize = 240;
+
+// Panel RAM in RGB565, rows of the unrotated panel.
+extern uint16_t panel[kPanelSize * kPanelSize];
+// Commands received since reset().
+extern uint32_t commands;
+
+// Clears panel RAM and the command count; the panel's configuration stays.
+void reset();
+
+// Whether a panel pixel lies under the round glass.
+bool visible(int x, int y);
+
+// Maps `data` as the image pack partition; nullptr removes it. The bytes
+// must outlive every use.
+void setImagePartition(const uint8_t *data, size_t size);
+
+// Whether MALLOC_CAP_SPIRAM allocations succeed. Off by default, like the
+// devkit the firmware targets.
+void setPsramAvailable(bool available);
+
+}  // namespace sim
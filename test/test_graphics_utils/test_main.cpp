@@ -0,0 +1,155 @@
+// ClipStack on its own: nesting past kMaxDepth, a clip that comes out
+// empty, and rects pushed and clipped from a rotated frame, each checked
+// against the rect the stack should hold.
+
+#include <unity.h>
+
+#include "graphics_utils.h"
+
+namespace {
+
+constexpr int16_t kSize = 240;
+
+struct Rect {
+  int16_t x0;
+  int16_t y0;
+  int16_t x1;
+  int16_t y1;
+};
+
+// What clip() leaves of the whole surface, in the stack's frame.
+bool clipped(const graphics::ClipStack &stack, Rect &out) {
+  out = {0, 0, kSize - 1, kSize - 1};
+  return stack.clip(out.x0, out.y0, out.x1, out.y1);
+}
+
+void assertClip(const graphics::ClipStack &stack, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  Rect rect;
+  TEST_ASSERT_TRUE(clipped(stack, rect));
+  TEST_ASSERT_EQUAL_INT(x0, rect.x0);
+  TEST_ASSERT_EQUAL_INT(y0, rect.y0);
+  TEST_ASSERT_EQUAL_INT(x1, rect.x1);
+  TEST_ASSERT_EQUAL_INT(y1, rect.y1);
+}
+
+void test_empty_stack_is_the_surface() {
+  graphics::ClipStack stack(kSize);
+  TEST_ASSERT_FALSE(stack.active());
+  assertClip(stack, 0, 0, kSize - 1, kSize - 1);
+  // Off-surface rects are cut to the surface.
+  Rect rect{-20, -5, 300, 10};
+  TEST_ASSERT_TRUE(stack.clip(rect.x0, rect.y0, rect.x1, rect.y1));
+  TEST_ASSERT_EQUAL_INT(0, rect.x0);
+  TEST_ASSERT_EQUAL_INT(0, rect.y0);
+  TEST_ASSERT_EQUAL_INT(kSize - 1, rect.x1);
+  TEST_ASSERT_EQUAL_INT(10, rect.y1);
+}
+
+void test_push_intersects_and_pop_restores() {
+  graphics::ClipStack stack(kSize);
+  stack.push(100, 80, 10, 20, 0);  // corners in either order
+  TEST_ASSERT_TRUE(stack.active());
+  assertClip(stack, 10, 20, 100, 80);
+  stack.push(50, 0, 200, 60, 0);
+  assertClip(stack, 50, 20, 100, 60);
+  stack.pop();
+  assertClip(stack, 10, 20, 100, 80);
+  stack.pop();
+  TEST_ASSERT_FALSE(stack.active());
+  assertClip(stack, 0, 0, kSize - 1, kSize - 1);
+  // Unbalanced pops are ignored.
+  stack.pop();
+  TEST_ASSERT_FALSE(stack.active());
+}
+
+// Level k + 1 narrows level k by one pixel a side, so the clip at each
+// depth tells which level is on top.
+void test_push_past_max_depth() {
+  constexpr uint8_t kDepth = graphics::ClipStack::kMaxDepth + 4;
+  graphics::ClipStack stack(kSize);
+  for (int16_t k = 1; k <= kDepth; ++k) {
+    stack.push(k, k, kSize - 1 - k, kSize - 1 - k, 0);
+    assertClip(stack, k, k, kSize - 1 - k, kSize - 1 - k);
+  }
+  // Popping back down to kMaxDepth keeps the narrowest clip, since the
+  // extra pushes narrowed the deepest level in place.
+  for (int16_t k = kDepth; k > graphics::ClipStack::kMaxDepth; --k) {
+    stack.pop();
+    assertClip(stack, kDepth, kDepth, kSize - 1 - kDepth, kSize - 1 - kDepth);
+  }
+  // Below it every level is back as pushed.
+  for (int16_t k = graphics::ClipStack::kMaxDepth - 1; k >= 1; --k) {
+    stack.pop();
+    assertClip(stack, k, k, kSize - 1 - k, kSize - 1 - k);
+  }
+  stack.pop();
+  TEST_ASSERT_FALSE(stack.active());
+}
+
+void test_empty_clip_clips_everything() {
+  graphics::ClipStack stack(kSize);
+  stack.push(10, 10, 50, 50, 0);
+  stack.push(60, 60, 90, 90, 0);  // disjoint from the level below
+  TEST_ASSERT_TRUE(stack.active());
+  Rect rect;
+  TEST_ASSERT_FALSE(clipped(stack, rect));
+  Rect logical{0, 0, kSize - 1, kSize - 1};
+  TEST_ASSERT_FALSE(stack.clip(logical.x0, logical.y0, logical.x1, logical.y1, 1));
+  // Anything pushed on top of it stays empty.
+  stack.push(0, 0, kSize - 1, kSize - 1, 0);
+  TEST_ASSERT_FALSE(clipped(stack, rect));
+  stack.pop();
+  stack.pop();
+  assertClip(stack, 10, 10, 50, 50);
+}
+
+// A rect pushed from a rotated frame covers the same pixels as the
+// rotated rect pushed from the stack's own, and clip() with the same turns
+// hands the cut back in the logical frame it was given in.
+void test_rotated_push_against_logical_rect() {
+  for (uint8_t turns = 0; turns < 4; ++turns) {
+    graphics::ClipStack stack(kSize);
+    stack.push(20, 30, 119, 69, turns);
+
+    Rect panel{20, 30, 119, 69};
+    graphics::rotateRect(panel.x0, panel.y0, panel.x1, panel.y1, turns, kSize);
+    assertClip(stack, panel.x0, panel.y0, panel.x1, panel.y1);
+
+    // Straddles the clip's right and bottom edges in the logical frame.
+    Rect logical{100, 60, 200, 100};
+    TEST_ASSERT_TRUE(stack.clip(logical.x0, logical.y0, logical.x1, logical.y1, turns));
+    TEST_ASSERT_EQUAL_INT(100, logical.x0);
+    TEST_ASSERT_EQUAL_INT(60, logical.y0);
+    TEST_ASSERT_EQUAL_INT(119, logical.x1);
+    TEST_ASSERT_EQUAL_INT(69, logical.y1);
+
+    Rect outside{120, 30, 200, 69};
+    TEST_ASSERT_FALSE(stack.clip(outside.x0, outside.y0, outside.x1, outside.y1, turns));
+  }
+}
+
+void test_rotated_clip_on_inactive_stack_is_untouched() {
+  graphics::ClipStack stack(kSize);
+  Rect rect{-10, 5, 300, 12};
+  TEST_ASSERT_TRUE(stack.clip(rect.x0, rect.y0, rect.x1, rect.y1, 1));
+  TEST_ASSERT_EQUAL_INT(-10, rect.x0);
+  TEST_ASSERT_EQUAL_INT(5, rect.y0);
+  TEST_ASSERT_EQUAL_INT(300, rect.x1);
+  TEST_ASSERT_EQUAL_INT(12, rect.y1);
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_stack_is_the_surface);
+  RUN_TEST(test_push_intersects_and_pop_restores);
+  RUN_TEST(test_push_past_max_depth);
+  RUN_TEST(test_empty_clip_clips_everything);
+  RUN_TEST(test_rotated_push_against_logical_rect);
+  RUN_TEST(test_rotated_clip_on_inactive_stack_is_untouched);
+  return UNITY_END();
+}
@@ -0,0 +1,171 @@
+// Image pack lookups against a pack built here: an intact image decodes,
+// and entries whose row table or rows fall outside the pack, as in a
+// truncated or corrupt partition, are rejected rather than read.
+
+#include <unity.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "image_pack.h"
+#include "sim.h"
+
+namespace {
+
+constexpr size_t kHeaderBytes = 12;
+constexpr size_t kNameBytes = 16;
+constexpr size_t kEntryBytes = kNameBytes + 8;
+
+struct PackImage {
+  std::string name;
+  uint16_t width;
+  uint16_t height;
+  std::vector<std::vector<uint8_t>> rows;
+};
+
+void put16(std::vector<uint8_t> &out, size_t at, uint16_t value) {
+  out[at] = static_cast<uint8_t>(value);
+  out[at + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+void put32(std::vector<uint8_t> &out, size_t at, uint32_t value) {
+  put16(out, at, static_cast<uint16_t>(value));
+  put16(out, at + 2, static_cast<uint16_t>(value >> 16));
+}
+
+std::vector<uint8_t> literal(std::initializer_list<uint16_t> pixels) {
+  std::vector<uint8_t> op = {static_cast<uint8_t>(pixels.size() - 1)};
+  for (uint16_t pixel : pixels) {
+    op.push_back(static_cast<uint8_t>(pixel));
+    op.push_back(static_cast<uint8_t>(pixel >> 8));
+  }
+  return op;
+}
+
+std::vector<uint8_t> run(uint16_t pixel, uint8_t length) {
+  return {static_cast<uint8_t>(0x80 | (length - 1)), static_cast<uint8_t>(pixel), static_cast<uint8_t>(pixel >> 8)};
+}
+
+// The layout tools/image_pack.py writes, with the entry offset of each
+// image returned in `entries`.
+std::vector<uint8_t> buildPack(const std::vector<PackImage> &images, std::vector<size_t> &entries) {
+  std::vector<uint8_t> pack(kHeaderBytes + images.size() * kEntryBytes);
+  std::memcpy(pack.data(), "HIMG", 4);
+  put16(pack, 4, 1);
+  put16(pack, 6, static_cast<uint16_t>(images.size()));
+  for (size_t i = 0; i < images.size(); ++i) {
+    const PackImage &image = images[i];
+    const size_t entry = kHeaderBytes + i * kEntryBytes;
+    entries.push_back(entry);
+    std::memcpy(pack.data() + entry, image.name.c_str(), image.name.size());
+    put16(pack, entry + kNameBytes, image.width);
+    put16(pack, entry + kNameBytes + 2, image.height);
+    put32(pack, entry + kNameBytes + 4, static_cast<uint32_t>(pack.size()));
+    const size_t table = pack.size();
+    pack.resize(table + image.rows.size() * 4);
+    uint32_t offset = 0;
+    for (size_t y = 0; y < image.rows.size(); ++y) {
+      put32(pack, table + y * 4, offset);
+      pack.insert(pack.end(), image.rows[y].begin(), image.rows[y].end());
+      offset += static_cast<uint32_t>(image.rows[y].size());
+    }
+  }
+  put32(pack, 8, static_cast<uint32_t>(pack.size()));
+  return pack;
+}
+
+std::vector<uint8_t> concat(std::vector<uint8_t> a, const std::vector<uint8_t> &b) {
+  a.insert(a.end(), b.begin(), b.end());
+  return a;
+}
+
+// Sized to the pack exactly, so a read past it is a heap overflow.
+std::vector<uint8_t> *s_partition = nullptr;
+
+void mapPack() {
+  const std::vector<PackImage> images = {
+    {"dial", 3, 2, {literal({0x1234, 0x5678, 0x9ABC}), run(0xF800, 3)}},
+    // Claims 2000 rows, so its row table runs past the end of the pack.
+    {"tall", 3, 2, {run(0x07E0, 3), run(0x07E0, 3)}},
+    // Its data offset lies past the end of the pack.
+    {"far", 3, 1, {run(0x001F, 3)}},
+    // Its second row's offset lies past the end of the pack.
+    {"stray", 3, 2, {run(0x001F, 3), run(0x001F, 3)}},
+    // Its last row is cut short by the truncation below.
+    {"cut", 3, 2, {run(0xFFFF, 3), concat(literal({1, 2}), literal({3}))}},
+  };
+  std::vector<size_t> entries;
+  std::vector<uint8_t> pack = buildPack(images, entries);
+  put16(pack, entries[1] + kNameBytes + 2, 2000);
+  put32(pack, entries[2] + kNameBytes + 4, 0xFFFFFFF0u);
+  const size_t strayTable = pack[entries[3] + kNameBytes + 4] | (pack[entries[3] + kNameBytes + 5] << 8);
+  put32(pack, strayTable + 4, 0x7FFFFFFFu);
+  // Drops the last pixel of "cut", as a pack written short would.
+  pack.resize(pack.size() - 2);
+  put32(pack, 8, static_cast<uint32_t>(pack.size()));
+
+  s_partition = new std::vector<uint8_t>(pack);
+  sim::setImagePartition(s_partition->data(), s_partition->size());
+}
+
+void test_begin_reads_the_pack() {
+  TEST_ASSERT_TRUE(image_pack::begin());
+  TEST_ASSERT_EQUAL_UINT16(5, image_pack::count());
+}
+
+void test_intact_image_decodes() {
+  image_pack::Image image;
+  TEST_ASSERT_TRUE(image_pack::find("dial", image));
+  TEST_ASSERT_EQUAL_UINT16(3, image.width);
+  TEST_ASSERT_EQUAL_UINT16(2, image.height);
+  uint16_t pixels[6] = {};
+  image_pack::unpack(image, pixels);
+  const uint16_t expected[6] = {0x1234, 0x5678, 0x9ABC, 0xF800, 0xF800, 0xF800};
+  TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, pixels, 6);
+}
+
+void test_row_table_past_the_end_is_rejected() {
+  image_pack::Image image;
+  TEST_ASSERT_FALSE(image_pack::find("tall", image));
+  TEST_ASSERT_NULL(image.rows);
+}
+
+void test_data_offset_past_the_end_is_rejected() {
+  image_pack::Image image;
+  TEST_ASSERT_FALSE(image_pack::find("far", image));
+  TEST_ASSERT_NULL(image.rows);
+}
+
+void test_row_offset_past_the_end_is_rejected() {
+  image_pack::Image image;
+  TEST_ASSERT_FALSE(image_pack::find("stray", image));
+  TEST_ASSERT_NULL(image.rows);
+}
+
+void test_truncated_row_is_rejected() {
+  image_pack::Image image;
+  TEST_ASSERT_FALSE(image_pack::imageAt(4, image));
+  TEST_ASSERT_NULL(image.rows);
+  // Nothing to draw, so drawImage and unpack leave the output alone.
+  uint16_t pixels[6] = {};
+  image_pack::unpack(image, pixels);
+  TEST_ASSERT_EQUAL_UINT16(0, pixels[0]);
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  mapPack();
+  UNITY_BEGIN();
+  RUN_TEST(test_begin_reads_the_pack);
+  RUN_TEST(test_intact_image_decodes);
+  RUN_TEST(test_row_table_past_the_end_is_rejected);
+  RUN_TEST(test_data_offset_past_the_end_is_rejected);
+  RUN_TEST(test_row_offset_past_the_end_is_rejected);
+  RUN_TEST(test_truncated_row_is_rejected);
+  return UNITY_END();
+}
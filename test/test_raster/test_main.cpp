@@ -0,0 +1,544 @@
+// The raster:: walkers against brute-force references that test every
+// pixel center on their own: polygons with the top-left rule, lines
+// against the per-pixel Bresenham they replace, wide lines and polylines
+// against the band they describe, and discs, rings and arcs against their
+// distance and half-plane tests. Every mode of every backend draws
+// through these, so the render-mode tests cannot catch a mistake here.
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "raster.h"
+
+namespace raster = graphics::raster;
+
+namespace {
+
+using Pixel = std::pair<int, int>;
+using Coverage = std::map<Pixel, int>;
+
+// Counts how often each pixel is emitted.
+struct CountingSink {
+  Coverage &cover;
+  void hspan(int16_t x0, int16_t x1, int16_t y) {
+    TEST_ASSERT_TRUE(x0 <= x1);
+    for (int x = x0; x <= x1; ++x) ++cover[{x, y}];
+  }
+  void vspan(int16_t x, int16_t y0, int16_t y1) {
+    TEST_ASSERT_TRUE(y0 <= y1);
+    for (int y = y0; y <= y1; ++y) ++cover[{x, y}];
+  }
+};
+
+uint32_t rngState = 2024;
+
+int32_t randomIn(int32_t lo, int32_t hi) {
+  rngState = rngState * 1664525u + 1013904223u;
+  return lo + static_cast<int32_t>((rngState >> 8) % static_cast<uint32_t>(hi - lo + 1));
+}
+
+// Every pixel emitted at most once, and exactly the pixels of `expected`.
+void checkCoverage(const Coverage &actual, const std::vector<Pixel> &expected, const char *what) {
+  char message[160];
+  const std::set<Pixel> wanted(expected.begin(), expected.end());
+  for (const auto &entry : actual) {
+    if (entry.second != 1) {
+      snprintf(message, sizeof(message), "%s: pixel %d,%d emitted %d times", what, entry.first.first,
+               entry.first.second, entry.second);
+      TEST_FAIL_MESSAGE(message);
+    }
+    if (!wanted.count(entry.first)) {
+      snprintf(message, sizeof(message), "%s: pixel %d,%d is outside the reference", what, entry.first.first,
+               entry.first.second);
+      TEST_FAIL_MESSAGE(message);
+    }
+  }
+  for (const Pixel &pixel : wanted) {
+    if (!actual.count(pixel)) {
+      snprintf(message, sizeof(message), "%s: pixel %d,%d missing", what, pixel.first, pixel.second);
+      TEST_FAIL_MESSAGE(message);
+    }
+  }
+}
+
+// Pixel centers inside a convex polygon given in 28.4, by exact integer
+// tests: a row is covered when its center lies in [top, bottom) of an
+// edge, and a pixel when its center lies in [left, right) of the row's two
+// edge crossings.
+std::vector<Pixel> referencePolygon(const raster::SubPoint *points, uint8_t count) {
+  std::vector<Pixel> pixels;
+  if (count < 3 || count > raster::kMaxPolygonVertices) return pixels;
+  int32_t top = INT32_MAX;
+  int32_t bottom = INT32_MIN;
+  for (uint8_t i = 0; i < count; ++i) {
+    top = std::min(top, points[i].y);
+    bottom = std::max(bottom, points[i].y);
+  }
+  for (int y = (top >> 4) - 1; y <= (bottom >> 4) + 1; ++y) {
+    const int64_t cy = y * 16 + 8;
+    // Crossings as num / den in 1/16 px, den > 0.
+    int64_t num[2];
+    int64_t den[2];
+    int crossings = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+      raster::SubPoint a = points[i];
+      raster::SubPoint b = points[(i + 1) % count];
+      if (a.y > b.y) std::swap(a, b);
+      if (!(a.y <= cy && cy < b.y)) continue;
+      TEST_ASSERT_TRUE(crossings < 2);
+      den[crossings] = b.y - a.y;
+      num[crossings] = static_cast<int64_t>(a.x) * den[crossings] + static_cast<int64_t>(b.x - a.x) * (cy - a.y);
+      ++crossings;
+    }
+    if (crossings == 0) continue;
+    TEST_ASSERT_EQUAL(2, crossings);
+    const int left = num[0] * den[1] <= num[1] * den[0] ? 0 : 1;
+    const int right = 1 - left;
+    const int64_t lo = num[left] / den[left] / 16 - 2;
+    const int64_t hi = num[right] / den[right] / 16 + 2;
+    for (int64_t x = lo; x <= hi; ++x) {
+      const int64_t cx = x * 16 + 8;
+      if (cx * den[left] >= num[left] && cx * den[right] < num[right]) {
+        pixels.push_back({static_cast<int>(x), y});
+      }
+    }
+  }
+  return pixels;
+}
+
+Coverage drawPolygon(const raster::SubPoint *points, uint8_t count) {
+  Coverage cover;
+  raster::convexPolygon(points, count, CountingSink{cover});
+  return cover;
+}
+
+// A random convex polygon in 28.4 around (cx, cy): sorted angles on an
+// ellipse, so it is convex, in either winding.
+uint8_t randomConvex(raster::SubPoint *points, int32_t cx, int32_t cy, int32_t radius) {
+  const uint8_t count = static_cast<uint8_t>(randomIn(3, raster::kMaxPolygonVertices));
+  std::vector<int32_t> angles;
+  for (uint8_t i = 0; i < count; ++i) angles.push_back(randomIn(0, 3599));
+  std::sort(angles.begin(), angles.end());
+  const bool reverse = randomIn(0, 1) == 1;
+  const int32_t rx = randomIn(radius / 4, radius);
+  const int32_t ry = randomIn(radius / 4, radius);
+  for (uint8_t i = 0; i < count; ++i) {
+    const float a = angles[reverse ? count - 1 - i : i] * 3.14159265f / 1800.0f;
+    points[i] = {cx + static_cast<int32_t>(std::lround(rx * std::cos(a))),
+                 cy + static_cast<int32_t>(std::lround(ry * std::sin(a)))};
+  }
+  return count;
+}
+
+void test_polygon_matches_reference() {
+  char what[64];
+  for (int k = 0; k < 400; ++k) {
+    raster::SubPoint points[raster::kMaxPolygonVertices];
+    const uint8_t count = randomConvex(points, randomIn(0, 240 * 16), randomIn(0, 240 * 16), randomIn(8, 60 * 16));
+    snprintf(what, sizeof(what), "polygon %d", k);
+    checkCoverage(drawPolygon(points, count), referencePolygon(points, count), what);
+  }
+}
+
+// Vertices exactly on pixel centers and on the half-way lines between
+// them, where the top-left rule decides.
+void test_polygon_on_pixel_centers() {
+  char what[64];
+  for (int k = 0; k < 300; ++k) {
+    raster::SubPoint points[raster::kMaxPolygonVertices];
+    const uint8_t count = randomConvex(points, randomIn(20, 200) * 16 + 8, randomIn(20, 200) * 16 + 8, 160);
+    for (uint8_t i = 0; i < count; ++i) {
+      points[i].x = (points[i].x & ~7) | (k & 1 ? 0 : 8);
+      points[i].y = (points[i].y & ~7) | (k & 2 ? 0 : 8);
+    }
+    snprintf(what, sizeof(what), "snapped polygon %d", k);
+    checkCoverage(drawPolygon(points, count), referencePolygon(points, count), what);
+  }
+}
+
+// Triangles fanned around an inner point tile their polygon: every pixel
+// of it comes out exactly once across all of them.
+void test_shared_edges_cover_once() {
+  for (int k = 0; k < 200; ++k) {
+    raster::SubPoint points[raster::kMaxPolygonVertices];
+    const uint8_t count = randomConvex(points, randomIn(40, 200) * 16, randomIn(40, 200) * 16, 40 * 16);
+    raster::SubPoint hub{0, 0};
+    for (uint8_t i = 0; i < count; ++i) {
+      hub.x += points[i].x;
+      hub.y += points[i].y;
+    }
+    hub = {hub.x / count, hub.y / count};
+    if (k & 1) hub = {(hub.x & ~15) + 8, (hub.y & ~15) + 8};
+
+    Coverage cover;
+    for (uint8_t i = 0; i < count; ++i) {
+      const raster::SubPoint triangle[3] = {hub, points[i], points[(i + 1) % count]};
+      raster::convexPolygon(triangle, 3, CountingSink{cover});
+    }
+    checkCoverage(cover, referencePolygon(points, count), "fan");
+  }
+}
+
+void test_degenerate_polygons() {
+  // Fewer than three points, too many, all on one line, all on one point.
+  const raster::SubPoint two[2] = {{8, 8}, {400, 300}};
+  TEST_ASSERT_EQUAL(0, drawPolygon(two, 2).size());
+  raster::SubPoint many[raster::kMaxPolygonVertices + 1];
+  for (uint8_t i = 0; i <= raster::kMaxPolygonVertices; ++i) many[i] = {i * 32 + 8, (i * i) * 16 + 8};
+  TEST_ASSERT_EQUAL(0, drawPolygon(many, raster::kMaxPolygonVertices + 1).size());
+  const raster::SubPoint line[3] = {{8, 8}, {168, 88}, {328, 168}};
+  TEST_ASSERT_EQUAL(0, drawPolygon(line, 3).size());
+  const raster::SubPoint flat[4] = {{8, 40}, {300, 40}, {500, 40}, {20, 40}};
+  TEST_ASSERT_EQUAL(0, drawPolygon(flat, 4).size());
+  const raster::SubPoint point[3] = {{100, 100}, {100, 100}, {100, 100}};
+  TEST_ASSERT_EQUAL(0, drawPolygon(point, 3).size());
+  // Thinner than a pixel and between centers: nothing is inside.
+  const raster::SubPoint sliver[4] = {{0, 20}, {320, 20}, {320, 22}, {0, 22}};
+  TEST_ASSERT_EQUAL(0, drawPolygon(sliver, 4).size());
+}
+
+// Coordinates are not clipped here; backends clip the spans. Polygons
+// partly or wholly off the 240x240 screen still match the reference.
+void test_off_screen_polygons() {
+  char what[64];
+  for (int k = 0; k < 100; ++k) {
+    raster::SubPoint points[raster::kMaxPolygonVertices];
+    const int32_t cx = (k & 1 ? -1 : 1) * randomIn(0, 400) * 16;
+    const int32_t cy = (k & 2 ? -1 : 1) * randomIn(0, 400) * 16 + (k & 4 ? 240 * 16 : 0);
+    const uint8_t count = randomConvex(points, cx, cy, randomIn(8, 40 * 16));
+    snprintf(what, sizeof(what), "off-screen polygon %d", k);
+    checkCoverage(drawPolygon(points, count), referencePolygon(points, count), what);
+  }
+}
+
+std::vector<Pixel> referenceLine(int x0, int y0, int x1, int y1) {
+  std::vector<Pixel> pixels;
+  const int dx = std::abs(x1 - x0);
+  const int sx = x0 < x1 ? 1 : -1;
+  const int dy = -std::abs(y1 - y0);
+  const int sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+  while (true) {
+    pixels.push_back({x0, y0});
+    if (x0 == x1 && y0 == y1) break;
+    const int e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y0 += sy;
+    }
+  }
+  return pixels;
+}
+
+// Runs follow the line's major axis and are maximal: two runs never
+// continue each other along it.
+struct RunSink {
+  std::vector<std::pair<Pixel, Pixel>> runs;
+  void hspan(int16_t x0, int16_t x1, int16_t y) { runs.push_back({{x0, y}, {x1, y}}); }
+  void vspan(int16_t x, int16_t y0, int16_t y1) { runs.push_back({{x, y0}, {x, y1}}); }
+};
+
+void test_line_runs_match_bresenham() {
+  char what[64];
+  for (int k = 0; k < 2000; ++k) {
+    const int x0 = randomIn(-40, 280);
+    const int y0 = randomIn(-40, 280);
+    const int x1 = k % 10 == 0 ? x0 : randomIn(-40, 280);
+    const int y1 = k % 10 == 1 ? y0 : randomIn(-40, 280);
+    Coverage cover;
+    raster::lineRuns(x0, y0, x1, y1, CountingSink{cover});
+    snprintf(what, sizeof(what), "line %d,%d-%d,%d", x0, y0, x1, y1);
+    checkCoverage(cover, referenceLine(x0, y0, x1, y1), what);
+
+    RunSink sink;
+    raster::lineRuns(x0, y0, x1, y1, sink);
+    const bool xMajor = std::abs(x1 - x0) >= std::abs(y1 - y0);
+    for (size_t i = 0; i < sink.runs.size(); ++i) {
+      const auto &run = sink.runs[i];
+      if (xMajor) TEST_ASSERT_EQUAL_MESSAGE(run.first.second, run.second.second, what);
+      if (!xMajor) TEST_ASSERT_EQUAL_MESSAGE(run.first.first, run.second.first, what);
+      if (i > 0) {
+        const auto &prev = sink.runs[i - 1];
+        if (xMajor) TEST_ASSERT_TRUE_MESSAGE(prev.first.second != run.first.second, what);
+        if (!xMajor) TEST_ASSERT_TRUE_MESSAGE(prev.first.first != run.first.first, what);
+      }
+    }
+  }
+}
+
+// Signed distances of a pixel center from a segment's line (across) and
+// along it from the first endpoint, in pixels.
+void bandCoordinates(int px, int py, int x0, int y0, int x1, int y1, double &across, double &along, double &length) {
+  const double dx = x1 - x0;
+  const double dy = y1 - y0;
+  length = std::sqrt(dx * dx + dy * dy);
+  const double ux = length > 0 ? dx / length : 1.0;
+  const double uy = length > 0 ? dy / length : 0.0;
+  along = (px - x0) * ux + (py - y0) * uy;
+  across = -(px - x0) * uy + (py - y0) * ux;
+}
+
+// A wide line covers the pixels whose centers lie in the band `width`
+// wide around the segment, extended half a pixel past each end. Its
+// corners are rounded to 1/16 px, so only centers clearly inside or
+// clearly outside are checked.
+void test_wide_line_matches_band() {
+  char what[80];
+  constexpr double kSlack = 0.13;
+  for (int k = 0; k < 600; ++k) {
+    const int x0 = randomIn(0, 239);
+    const int y0 = randomIn(0, 239);
+    const int x1 = k % 15 == 0 ? x0 : randomIn(0, 239);
+    const int y1 = k % 15 == 0 ? y0 : randomIn(0, 239);
+    const uint8_t width = static_cast<uint8_t>(randomIn(2, 9));
+    Coverage cover;
+    raster::wideLine(x0, y0, x1, y1, width, CountingSink{cover});
+    snprintf(what, sizeof(what), "wide line %d,%d-%d,%d w%d", x0, y0, x1, y1, width);
+    for (const auto &entry : cover) TEST_ASSERT_EQUAL_MESSAGE(1, entry.second, what);
+    for (int py = std::min(y0, y1) - width - 2; py <= std::max(y0, y1) + width + 2; ++py) {
+      for (int px = std::min(x0, x1) - width - 2; px <= std::max(x0, x1) + width + 2; ++px) {
+        double across, along, length;
+        bandCoordinates(px, py, x0, y0, x1, y1, across, along, length);
+        const double half = width / 2.0;
+        const bool clearlyIn = std::fabs(across) < half - kSlack && along > -0.5 + kSlack && along < length + 0.5 - kSlack;
+        const bool clearlyOut = std::fabs(across) > half + kSlack || along < -0.5 - kSlack || along > length + 0.5 + kSlack;
+        const bool covered = cover.count({px, py}) != 0;
+        if (clearlyIn) TEST_ASSERT_TRUE_MESSAGE(covered, what);
+        if (clearlyOut) TEST_ASSERT_FALSE_MESSAGE(covered, what);
+      }
+    }
+  }
+}
+
+void test_wide_line_of_width_zero_draws_nothing() {
+  Coverage cover;
+  raster::wideLine(10, 10, 100, 50, 0, CountingSink{cover});
+  TEST_ASSERT_EQUAL(0, cover.size());
+}
+
+// A polyline is its segments: for width 1 the Bresenham path of each, for
+// wider ones the band of each. At every join the shared vertex is drawn,
+// and for width 1 the path stays 8-connected through it.
+void test_polyline_joins() {
+  char what[64];
+  for (int k = 0; k < 300; ++k) {
+    const uint8_t count = static_cast<uint8_t>(randomIn(1, 6));
+    graphics::Point points[6];
+    for (uint8_t i = 0; i < count; ++i) {
+      points[i] = {static_cast<int16_t>(randomIn(0, 239)), static_cast<int16_t>(randomIn(0, 239))};
+    }
+    const uint8_t width = static_cast<uint8_t>(k % 3 == 0 ? randomIn(2, 7) : 1);
+    snprintf(what, sizeof(what), "polyline %d w%d", k, width);
+
+    Coverage cover;
+    raster::polyline(points, count, width, CountingSink{cover});
+    Coverage segments;
+    for (uint8_t i = count > 1 ? 1 : 0; i < count; ++i) {
+      const graphics::Point &from = points[i > 0 ? i - 1 : 0];
+      if (width > 1) {
+        raster::wideLine(from.x, from.y, points[i].x, points[i].y, width, CountingSink{segments});
+      } else {
+        for (const Pixel &pixel : referenceLine(from.x, from.y, points[i].x, points[i].y)) ++segments[pixel];
+      }
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(segments.size(), cover.size(), what);
+    for (const auto &entry : segments) {
+      TEST_ASSERT_EQUAL_MESSAGE(entry.second, cover.count(entry.first) ? cover.at(entry.first) : 0, what);
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+      TEST_ASSERT_TRUE_MESSAGE(cover.count({points[i].x, points[i].y}) != 0, what);
+    }
+    if (width == 1) {
+      // Walk from the first point; every covered pixel must be reachable.
+      std::vector<Pixel> stack = {{points[0].x, points[0].y}};
+      std::map<Pixel, bool> seen = {{stack[0], true}};
+      while (!stack.empty()) {
+        const Pixel p = stack.back();
+        stack.pop_back();
+        for (int dy = -1; dy <= 1; ++dy) {
+          for (int dx = -1; dx <= 1; ++dx) {
+            const Pixel q{p.first + dx, p.second + dy};
+            if (cover.count(q) && !seen[q]) {
+              seen[q] = true;
+              stack.push_back(q);
+            }
+          }
+        }
+      }
+      size_t reached = 0;
+      for (const auto &entry : seen) reached += entry.second ? 1 : 0;
+      TEST_ASSERT_EQUAL_MESSAGE(cover.size(), reached, what);
+    }
+  }
+}
+
+// Offsets inside the disc x^2 + y^2 <= r^2 + r; a negative r has none.
+bool inDisc(int dx, int dy, int r) {
+  return r >= 0 && dx * dx + dy * dy <= r * r + r;
+}
+
+std::vector<Pixel> referenceRing(int cx, int cy, int rOuter, int rInner) {
+  std::vector<Pixel> pixels;
+  for (int dy = -rOuter; dy <= rOuter; ++dy) {
+    for (int dx = -rOuter; dx <= rOuter; ++dx) {
+      if (inDisc(dx, dy, rOuter) && !inDisc(dx, dy, rInner)) pixels.push_back({cx + dx, cy + dy});
+    }
+  }
+  return pixels;
+}
+
+void test_disc_matches_reference() {
+  char what[64];
+  for (int r = 0; r <= 60; ++r) {
+    Coverage cover;
+    raster::disc(120, 100, r, CountingSink{cover});
+    snprintf(what, sizeof(what), "disc r%d", r);
+    checkCoverage(cover, referenceRing(120, 100, r, -1), what);
+  }
+  Coverage none;
+  raster::disc(120, 100, -1, CountingSink{none});
+  TEST_ASSERT_EQUAL(0, none.size());
+}
+
+// The watch face hub is a radius 6 disc under a radius 3 one. This test
+// is not the midpoint fillCircle's: radius 1 is a 3x3 square rather than
+// a plus, and radius 6 has 137 pixels to its 129, filling the diagonals.
+void test_disc_shapes_of_the_hub() {
+  Coverage one;
+  raster::disc(10, 10, 1, CountingSink{one});
+  TEST_ASSERT_EQUAL(9, one.size());
+  for (int dy = -1; dy <= 1; ++dy) {
+    for (int dx = -1; dx <= 1; ++dx) TEST_ASSERT_TRUE(one.count({10 + dx, 10 + dy}) != 0);
+  }
+  Coverage three;
+  raster::disc(10, 10, 3, CountingSink{three});
+  TEST_ASSERT_EQUAL(37, three.size());
+  Coverage six;
+  raster::disc(10, 10, 6, CountingSink{six});
+  TEST_ASSERT_EQUAL(137, six.size());
+  TEST_ASSERT_TRUE(six.count({15, 14}) != 0);
+  TEST_ASSERT_TRUE(six.count({16, 13}) == 0);
+}
+
+void test_ring_matches_reference() {
+  char what[64];
+  for (int rOuter = 0; rOuter <= 40; ++rOuter) {
+    for (int rInner = -2; rInner <= rOuter + 1; ++rInner) {
+      Coverage cover;
+      raster::ring(100, 120, rOuter, rInner, CountingSink{cover});
+      snprintf(what, sizeof(what), "ring %d/%d", rOuter, rInner);
+      checkCoverage(cover, referenceRing(100, 120, rOuter, rInner), what);
+    }
+  }
+}
+
+// The unit vector arc() uses for a boundary ray, in 1/16384.
+void arcUnit(int32_t deg, int32_t &x, int32_t &y) {
+  x = static_cast<int32_t>(std::lround(std::cos(deg * 3.14159265f / 180.0f) * 16384.0f));
+  y = static_cast<int32_t>(std::lround(std::sin(deg * 3.14159265f / 180.0f) * 16384.0f));
+}
+
+// The ring pixels on or clockwise of the start ray and on or
+// counter-clockwise of the end ray of some piece of at most 180 degrees.
+std::vector<Pixel> referenceArc(int cx, int cy, int rOuter, int rInner, int startDeg, int endDeg) {
+  int sweep = ((endDeg - startDeg) % 360 + 360) % 360;
+  if (sweep == 0 && endDeg != startDeg) sweep = 360;
+  std::vector<Pixel> pixels;
+  for (const Pixel &pixel : referenceRing(0, 0, rOuter, rInner)) {
+    const int64_t dx = pixel.first;
+    const int64_t dy = pixel.second;
+    bool inside = sweep == 360;
+    for (int from = startDeg, left = sweep; left > 0 && !inside && sweep < 360;) {
+      const int len = std::min(left, 180);
+      int32_t sx, sy, ex, ey;
+      arcUnit(from, sx, sy);
+      arcUnit(from + len, ex, ey);
+      inside = sx * dy - sy * dx >= 0 && dx * ey - dy * ex >= 0;
+      from += len;
+      left -= len;
+    }
+    if (inside) pixels.push_back({cx + pixel.first, cy + pixel.second});
+  }
+  return pixels;
+}
+
+Coverage drawArc(int rOuter, int rInner, int startDeg, int endDeg) {
+  Coverage cover;
+  raster::arc(120, 120, rOuter, rInner, startDeg, endDeg, CountingSink{cover});
+  return cover;
+}
+
+void test_arc_matches_reference() {
+  char what[64];
+  for (int k = 0; k < 600; ++k) {
+    const int rOuter = randomIn(0, 60);
+    const int rInner = randomIn(-1, rOuter);
+    const int startDeg = randomIn(-360, 720);
+    const int endDeg = k % 10 == 0 ? startDeg + 180 : randomIn(-360, 720);
+    snprintf(what, sizeof(what), "arc %d/%d %d-%d", rOuter, rInner, startDeg, endDeg);
+    checkCoverage(drawArc(rOuter, rInner, startDeg, endDeg),
+                  referenceArc(120, 120, rOuter, rInner, startDeg, endDeg), what);
+  }
+}
+
+// Screen angles run clockwise from +x, so 90 degrees points down.
+void test_arc_boundaries() {
+  const std::vector<Pixel> ring = referenceRing(120, 120, 30, 10);
+  auto only = [&ring](bool (*keep)(int, int)) {
+    std::vector<Pixel> pixels;
+    for (const Pixel &pixel : ring) {
+      if (keep(pixel.first - 120, pixel.second - 120)) pixels.push_back(pixel);
+    }
+    return pixels;
+  };
+  // Exactly 180 degrees: the lower half, row 0 included on both sides.
+  checkCoverage(drawArc(30, 10, 0, 180), only([](int, int dy) { return dy >= 0; }), "0-180");
+  // Crossing 0/360: the right half.
+  checkCoverage(drawArc(30, 10, 270, 90), only([](int dx, int) { return dx >= 0; }), "270-90");
+  checkCoverage(drawArc(30, 10, -90, 90), only([](int dx, int) { return dx >= 0; }), "-90-90");
+  // A quarter across 0/360 and one wider than 180 degrees.
+  checkCoverage(drawArc(30, 10, 315, 45), only([](int dx, int dy) { return dx >= std::abs(dy); }), "315-45");
+  checkCoverage(drawArc(30, 10, 0, 270),
+                only([](int dx, int dy) { return dy >= 0 || dx <= 0; }), "0-270");
+  // Zero length draws nothing; a whole turn is the ring.
+  TEST_ASSERT_EQUAL(0, drawArc(30, 10, 45, 45).size());
+  TEST_ASSERT_EQUAL(0, drawArc(30, -1, 0, 0).size());
+  checkCoverage(drawArc(30, 10, 0, 360), ring, "0-360");
+  checkCoverage(drawArc(30, 10, 30, 390), ring, "30-390");
+  checkCoverage(drawArc(30, -1, 90, -270), referenceRing(120, 120, 30, -1), "90--270");
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_polygon_matches_reference);
+  RUN_TEST(test_polygon_on_pixel_centers);
+  RUN_TEST(test_shared_edges_cover_once);
+  RUN_TEST(test_degenerate_polygons);
+  RUN_TEST(test_off_screen_polygons);
+  RUN_TEST(test_line_runs_match_bresenham);
+  RUN_TEST(test_wide_line_matches_band);
+  RUN_TEST(test_wide_line_of_width_zero_draws_nothing);
+  RUN_TEST(test_polyline_joins);
+  RUN_TEST(test_disc_matches_reference);
+  RUN_TEST(test_disc_shapes_of_the_hub);
+  RUN_TEST(test_ring_matches_reference);
+  RUN_TEST(test_arc_matches_reference);
+  RUN_TEST(test_arc_boundaries);
+  return UNITY_END();
+}
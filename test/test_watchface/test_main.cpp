@@ -0,0 +1,243 @@
+// Retained-face rendering on the host: after every tick of a simulated two
+// hundred seconds, what damage repaints left on the panel must equal a full
+// repaint, in each of display_manager's render modes, and equal what
+// drawing straight to the panel shows.
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+#include "gc9a01_graphics.h"
+#include "hardware_pins.h"
+#include "indexed_canvas.h"
+#include "recording_graphics.h"
+#include "sim.h"
+#include "watchface.h"
+
+namespace {
+
+enum class Mode { Direct, Recorded, Framebuffer, FrameDiff, Banded, Indexed4 };
+
+// The driver stack display_manager builds for `mode`, in the same order:
+// everything is configured before begin() initializes the panel.
+class Display {
+ public:
+  explicit Display(Mode mode)
+      : mode_(mode), driver_(pins::LCD_DC, pins::LCD_CS, pins::LCD_RST, true), recorder_(driver_), canvas_(driver_, 4) {}
+
+  bool begin() {
+    driver_.setRoundClipEnabled(true);
+    driver_.setPixelFormat(graphics::PixelFormat::Rgb444);
+    bool ok = true;
+    switch (mode_) {
+      case Mode::Direct:
+        break;
+      case Mode::Recorded:
+        ok = recorder_.begin();
+        break;
+      case Mode::Framebuffer:
+        ok = driver_.setFramebufferEnabled(true);
+        break;
+      case Mode::FrameDiff:
+        ok = driver_.setFramebufferEnabled(true) && driver_.setFrameDiffEnabled(true);
+        break;
+      case Mode::Banded:
+        ok = driver_.setBandedRenderingEnabled(true) && recorder_.begin();
+        break;
+      case Mode::Indexed4:
+        ok = canvas_.begin();
+        break;
+    }
+    return restart() && ok;
+  }
+
+  // Clears panel RAM and re-runs the panel init, as waking from sleep does;
+  // every buffer then resends its whole frame on the next paint.
+  bool restart() {
+    sim::reset();
+    if (!driver_.begin(40000000ul)) return false;
+    if (mode_ == Mode::Indexed4) canvas_.invalidate();
+    return true;
+  }
+
+  graphics::Graphics &get() {
+    if (mode_ == Mode::Recorded || mode_ == Mode::Banded) return recorder_;
+    if (mode_ == Mode::Indexed4) return canvas_;
+    return driver_;
+  }
+
+  // A full paint as render_task issues it; banded mode replays it per strip.
+  void drawFull() {
+    if (mode_ == Mode::Banded) {
+      recorder_.endFrame();
+      driver_.renderBanded([](graphics::Gc9a01Graphics &display, void *) { watchface::drawFull(display); }, nullptr);
+    } else {
+      watchface::drawFull(get());
+    }
+    finish();
+  }
+
+  void drawDamage() {
+    watchface::drawDamage(get());
+    finish();
+  }
+
+ private:
+  void finish() {
+    get().flush();
+    driver_.waitForTransfers();
+  }
+
+  Mode mode_;
+  graphics::Gc9a01Graphics driver_;
+  graphics::RecordingGraphics recorder_;
+  graphics::IndexedCanvas canvas_;
+};
+
+tm startTime() {
+  tm time{};
+  time.tm_hour = 10;
+  time.tm_min = 58;
+  time.tm_sec = 40;
+  time.tm_mday = 9;
+  time.tm_wday = 3;
+  return time;
+}
+
+// Advances one second; crosses the hour and the day at tick 80.
+void tick(tm &time) {
+  if (++time.tm_sec < 60) return;
+  time.tm_sec = 0;
+  if (++time.tm_min < 60) return;
+  time.tm_min = 0;
+  ++time.tm_hour;
+  ++time.tm_mday;
+  time.tm_wday = (time.tm_wday + 1) % 7;
+}
+
+// Pixels under the glass that differ, with the first one reported.
+int countDifferences(const std::vector<uint16_t> &expected, const char *what) {
+  int differences = 0;
+  for (int y = 0; y < sim::kPanelSize; ++y) {
+    for (int x = 0; x < sim::kPanelSize; ++x) {
+      const int i = y * sim::kPanelSize + x;
+      if (!sim::visible(x, y) || expected[i] == sim::panel[i]) continue;
+      if (differences++ == 0) {
+        char message[96];
+        snprintf(message, sizeof(message), "%s: first difference at %d,%d", what, x, y);
+        TEST_MESSAGE(message);
+      }
+    }
+  }
+  return differences;
+}
+
+void checkDamageMatchesFullRepaint(Mode mode) {
+  sim::setPsramAvailable(mode == Mode::FrameDiff);
+  Display display(mode);
+  TEST_ASSERT_TRUE(display.begin());
+
+  tm time = startTime();
+  uint32_t steps = 998;
+  uint8_t battery = 100;
+  watchface::update(time, steps, battery);
+  display.drawFull();
+
+  for (int k = 0; k < 200; ++k) {
+    tick(time);
+    if (k % 7 == 0) steps += 3;
+    if (k == 50) battery = 99;
+    if (k == 120) battery = 9;
+    watchface::update(time, steps, battery);
+    display.drawDamage();
+
+    const std::vector<uint16_t> incremental(sim::panel, sim::panel + sim::kPanelSize * sim::kPanelSize);
+    TEST_ASSERT_TRUE(display.restart());
+    display.drawFull();
+    char what[32];
+    snprintf(what, sizeof(what), "tick %d", k);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, countDifferences(incremental, what), what);
+  }
+}
+
+// Runs the same ticks in `mode` and, after each, compares the panel with a
+// full paint by a second stack that draws straight to the panel.
+void checkMatchesDirect(Mode mode) {
+  sim::setPsramAvailable(mode == Mode::FrameDiff);
+  Display display(mode);
+  Display direct(Mode::Direct);
+  TEST_ASSERT_TRUE(display.begin());
+  TEST_ASSERT_TRUE(direct.begin());
+
+  tm time = startTime();
+  watchface::update(time, 998, 100);
+  TEST_ASSERT_TRUE(display.restart());
+  display.drawFull();
+
+  for (int k = 0; k < 100; ++k) {
+    const std::vector<uint16_t> shown(sim::panel, sim::panel + sim::kPanelSize * sim::kPanelSize);
+    TEST_ASSERT_TRUE(direct.restart());
+    direct.drawFull();
+    char what[32];
+    snprintf(what, sizeof(what), "tick %d", k);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, countDifferences(shown, what), what);
+
+    // Back to what `display` left, for its next damage paint.
+    std::copy(shown.begin(), shown.end(), sim::panel);
+    tick(time);
+    watchface::update(time, 998 + k, 100);
+    display.drawDamage();
+  }
+}
+
+void test_damage_matches_full_repaint_direct() { checkDamageMatchesFullRepaint(Mode::Direct); }
+void test_damage_matches_full_repaint_recorded() { checkDamageMatchesFullRepaint(Mode::Recorded); }
+void test_damage_matches_full_repaint_framebuffer() { checkDamageMatchesFullRepaint(Mode::Framebuffer); }
+void test_damage_matches_full_repaint_frame_diff() { checkDamageMatchesFullRepaint(Mode::FrameDiff); }
+void test_damage_matches_full_repaint_banded() { checkDamageMatchesFullRepaint(Mode::Banded); }
+void test_damage_matches_full_repaint_indexed4() { checkDamageMatchesFullRepaint(Mode::Indexed4); }
+
+// The shown-frame copy is 115 KB on top of the framebuffer; internal RAM
+// cannot spare it next to BLE.
+void test_frame_diff_needs_psram() {
+  graphics::Gc9a01Graphics driver(pins::LCD_DC, pins::LCD_CS, pins::LCD_RST, true);
+  TEST_ASSERT_TRUE(driver.setFramebufferEnabled(true));
+  sim::setPsramAvailable(false);
+  TEST_ASSERT_FALSE(driver.setFrameDiffEnabled(true));
+  TEST_ASSERT_FALSE(driver.frameDiffEnabled());
+  sim::setPsramAvailable(true);
+  TEST_ASSERT_TRUE(driver.setFrameDiffEnabled(true));
+  TEST_ASSERT_TRUE(driver.frameDiffEnabled());
+}
+
+void test_recorded_matches_direct() { checkMatchesDirect(Mode::Recorded); }
+void test_framebuffer_matches_direct() { checkMatchesDirect(Mode::Framebuffer); }
+void test_frame_diff_matches_direct() { checkMatchesDirect(Mode::FrameDiff); }
+void test_banded_matches_direct() { checkMatchesDirect(Mode::Banded); }
+void test_indexed4_matches_direct() { checkMatchesDirect(Mode::Indexed4); }
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  watchface::init();
+  UNITY_BEGIN();
+  RUN_TEST(test_damage_matches_full_repaint_direct);
+  RUN_TEST(test_damage_matches_full_repaint_recorded);
+  RUN_TEST(test_damage_matches_full_repaint_framebuffer);
+  RUN_TEST(test_damage_matches_full_repaint_frame_diff);
+  RUN_TEST(test_damage_matches_full_repaint_banded);
+  RUN_TEST(test_damage_matches_full_repaint_indexed4);
+  RUN_TEST(test_frame_diff_needs_psram);
+  RUN_TEST(test_recorded_matches_direct);
+  RUN_TEST(test_framebuffer_matches_direct);
+  RUN_TEST(test_frame_diff_matches_direct);
+  RUN_TEST(test_banded_matches_direct);
+  RUN_TEST(test_indexed4_matches_direct);
+  return UNITY_END();
+}
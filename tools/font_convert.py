@@ -0,0 +1,385 @@
+#!/usr/bin/env python3
+"""Converts a TrueType font into an anti-aliased 4-bpp glyph header for aa_text.h.
+
+    python tools/font_convert.py Lato-Regular.ttf --height 14 \\
+        --chars " %0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" \\
+        --name lato14 -o include/font_lato14.h
+
+The font is scaled so the ink of --chars spans --height rows from the
+tallest glyph top to the lowest glyph bottom. Each glyph keeps its own
+advance (no kerning) and is stored trimmed to its ink, two pixels per
+byte, first pixel in the low nibble, 0 for none and 15 for full
+coverage. Coverage is exact across each pixel and sampled on eight
+lines down it. Only the standard library is needed: TrueType outlines
+(glyf) are read here; CFF-flavoured OpenType fonts are not supported.
+"""
+
+import argparse
+import math
+import os
+import struct
+import sys
+
+FIRST_CODE = 0x20
+LAST_CODE = 0x7E
+NO_GLYPH = 0xFF
+SUBSAMPLES = 8
+
+
+class TrueType:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        (num_tables,) = struct.unpack(">H", self.data[4:6])
+        self.tables = {}
+        for i in range(num_tables):
+            tag, _, offset, length = struct.unpack(">4sIII", self.data[12 + 16 * i:28 + 16 * i])
+            self.tables[tag.decode("latin-1")] = (offset, length)
+        if "glyf" not in self.tables:
+            raise ValueError(f"{path}: no TrueType outlines (glyf table)")
+
+        head = self.table("head")
+        self.units_per_em = struct.unpack(">H", head[18:20])[0]
+        self.long_loca = struct.unpack(">h", head[50:52])[0] == 1
+        self.num_glyphs = struct.unpack(">H", self.table("maxp")[4:6])[0]
+        self.num_h_metrics = struct.unpack(">H", self.table("hhea")[34:36])[0]
+        self.cmap = self.read_cmap()
+
+    def table(self, tag):
+        offset, length = self.tables[tag]
+        return self.data[offset:offset + length]
+
+    def read_cmap(self):
+        cmap = self.table("cmap")
+        (count,) = struct.unpack(">H", cmap[2:4])
+        best = None
+        for i in range(count):
+            platform, encoding, offset = struct.unpack(">HHI", cmap[4 + 8 * i:12 + 8 * i])
+            if (platform, encoding) in ((3, 1), (3, 10), (0, 3), (0, 4)):
+                (fmt,) = struct.unpack(">H", cmap[offset:offset + 2])
+                if fmt in (4, 12) and (best is None or fmt == 12):
+                    best = offset
+        if best is None:
+            raise ValueError("no Unicode cmap")
+        (fmt,) = struct.unpack(">H", cmap[best:best + 2])
+        mapping = {}
+        if fmt == 4:
+            (seg2,) = struct.unpack(">H", cmap[best + 6:best + 8])
+            ends = best + 14
+            starts = ends + seg2 + 2
+            deltas = starts + seg2
+            ranges = deltas + seg2
+            for s in range(seg2 // 2):
+                end, = struct.unpack(">H", cmap[ends + 2 * s:ends + 2 * s + 2])
+                start, = struct.unpack(">H", cmap[starts + 2 * s:starts + 2 * s + 2])
+                delta, = struct.unpack(">h", cmap[deltas + 2 * s:deltas + 2 * s + 2])
+                range_offset, = struct.unpack(">H", cmap[ranges + 2 * s:ranges + 2 * s + 2])
+                for code in range(start, min(end, 0xFFFE) + 1):
+                    if range_offset == 0:
+                        glyph = (code + delta) & 0xFFFF
+                    else:
+                        at = ranges + 2 * s + range_offset + 2 * (code - start)
+                        glyph, = struct.unpack(">H", cmap[at:at + 2])
+                        if glyph:
+                            glyph = (glyph + delta) & 0xFFFF
+                    mapping[code] = glyph
+        else:
+            (groups,) = struct.unpack(">I", cmap[best + 12:best + 16])
+            for g in range(groups):
+                start, end, glyph = struct.unpack(">III", cmap[best + 16 + 12 * g:best + 28 + 12 * g])
+                for code in range(start, min(end, 0x10FFFF) + 1):
+                    mapping[code] = glyph + code - start
+        return mapping
+
+    def advance(self, glyph):
+        hmtx = self.table("hmtx")
+        index = min(glyph, self.num_h_metrics - 1)
+        return struct.unpack(">H", hmtx[4 * index:4 * index + 2])[0]
+
+    def glyph_data(self, glyph):
+        loca = self.table("loca")
+        if self.long_loca:
+            start, end = struct.unpack(">II", loca[4 * glyph:4 * glyph + 8])
+        else:
+            start, end = (2 * v for v in struct.unpack(">HH", loca[2 * glyph:2 * glyph + 4]))
+        offset, _ = self.tables["glyf"]
+        return self.data[offset + start:offset + end]
+
+    def contours(self, glyph, depth=0):
+        """Returns the outline as lists of (x, y, on_curve) in font units."""
+        data = self.glyph_data(glyph)
+        if not data or depth > 8:
+            return []
+        (count,) = struct.unpack(">h", data[0:2])
+        if count >= 0:
+            return self.simple_contours(data, count)
+        return self.composite_contours(data, depth)
+
+    @staticmethod
+    def simple_contours(data, count):
+        ends = struct.unpack(f">{count}H", data[10:10 + 2 * count])
+        points = ends[-1] + 1 if ends else 0
+        pos = 10 + 2 * count
+        (instructions,) = struct.unpack(">H", data[pos:pos + 2])
+        pos += 2 + instructions
+        flags = []
+        while len(flags) < points:
+            flag = data[pos]
+            pos += 1
+            flags.append(flag)
+            if flag & 0x08:
+                repeat = data[pos]
+                pos += 1
+                flags.extend([flag] * repeat)
+        coords = []
+        for short_bit, same_bit in ((0x02, 0x10), (0x04, 0x20)):
+            value = 0
+            values = []
+            for flag in flags:
+                if flag & short_bit:
+                    delta = data[pos]
+                    pos += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    (delta,) = struct.unpack(">h", data[pos:pos + 2])
+                    pos += 2
+                    value += delta
+                values.append(value)
+            coords.append(values)
+        contours = []
+        start = 0
+        for end in ends:
+            contours.append([(coords[0][i], coords[1][i], bool(flags[i] & 1)) for i in range(start, end + 1)])
+            start = end + 1
+        return contours
+
+    def composite_contours(self, data, depth):
+        contours = []
+        pos = 10
+        while True:
+            flags, glyph = struct.unpack(">HH", data[pos:pos + 4])
+            pos += 4
+            if flags & 0x0001:
+                dx, dy = struct.unpack(">hh", data[pos:pos + 4])
+                pos += 4
+            else:
+                dx, dy = struct.unpack(">bb", data[pos:pos + 2])
+                pos += 2
+            a, b, c, d = 1.0, 0.0, 0.0, 1.0
+            if flags & 0x0008:
+                (a,) = struct.unpack(">h", data[pos:pos + 2])
+                a = d = a / 16384.0
+                pos += 2
+            elif flags & 0x0040:
+                a, d = (v / 16384.0 for v in struct.unpack(">hh", data[pos:pos + 4]))
+                pos += 4
+            elif flags & 0x0080:
+                a, b, c, d = (v / 16384.0 for v in struct.unpack(">hhhh", data[pos:pos + 8]))
+                pos += 8
+            if not flags & 0x0002:
+                dx = dy = 0  # point matching is not supported
+            for contour in self.contours(glyph, depth + 1):
+                contours.append([(a * x + c * y + dx, b * x + d * y + dy, on) for x, y, on in contour])
+            if not flags & 0x0020:
+                break
+        return contours
+
+
+def flatten(contour, scale):
+    """Turns one contour into a closed polygon in pixels, y pointing down."""
+    points = [(x * scale, -y * scale, on) for x, y, on in contour]
+    if not points:
+        return []
+    # Start on an on-curve point, inventing one between two off-curve points.
+    if not points[0][2]:
+        if points[-1][2]:
+            points = points[-1:] + points[:-1]
+        else:
+            mid = ((points[0][0] + points[-1][0]) / 2, (points[0][1] + points[-1][1]) / 2, True)
+            points = [mid] + points
+    polygon = [points[0][:2]]
+    control = None
+    for x, y, on in points[1:] + points[:1]:
+        if on:
+            if control is None:
+                polygon.append((x, y))
+            else:
+                quadratic(polygon, control, (x, y))
+                control = None
+        else:
+            if control is not None:
+                mid = ((control[0] + x) / 2, (control[1] + y) / 2)
+                quadratic(polygon, control, mid)
+            control = (x, y)
+    return polygon
+
+
+def quadratic(polygon, control, end):
+    start = polygon[-1]
+    length = math.hypot(control[0] - start[0], control[1] - start[1]) + math.hypot(end[0] - control[0], end[1] - control[1])
+    steps = max(2, int(length * 2))
+    for i in range(1, steps + 1):
+        t = i / steps
+        u = 1 - t
+        polygon.append((u * u * start[0] + 2 * u * t * control[0] + t * t * end[0],
+                        u * u * start[1] + 2 * u * t * control[1] + t * t * end[1]))
+
+
+def rasterize(polygons):
+    """Returns (left, top, rows of 0..15) with the pen at (0, 0) on the baseline."""
+    edges = []
+    for polygon in polygons:
+        for (x0, y0), (x1, y1) in zip(polygon, polygon[1:] + polygon[:1]):
+            if y0 != y1:
+                edges.append((x0, y0, x1, y1))
+    if not edges:
+        return 0, 0, []
+    left = math.floor(min(min(e[0], e[2]) for e in edges))
+    right = math.ceil(max(max(e[0], e[2]) for e in edges))
+    top = math.floor(min(min(e[1], e[3]) for e in edges))
+    bottom = math.ceil(max(max(e[1], e[3]) for e in edges))
+    width = right - left
+    rows = []
+    for row in range(top, bottom):
+        coverage = [0.0] * (width + 1)
+        for sub in range(SUBSAMPLES):
+            y = row + (sub + 0.5) / SUBSAMPLES
+            crossings = []
+            for x0, y0, x1, y1 in edges:
+                if (y0 <= y < y1) or (y1 <= y < y0):
+                    crossings.append((x0 + (y - y0) * (x1 - x0) / (y1 - y0), 1 if y1 > y0 else -1))
+            crossings.sort()
+            winding = 0
+            for i, (x, direction) in enumerate(crossings):
+                was_inside = winding != 0
+                winding += direction
+                if not was_inside and winding != 0:
+                    start = x
+                elif was_inside and winding == 0:
+                    add_span(coverage, start - left, x - left)
+        rows.append([min(15, int(c / SUBSAMPLES * 15 + 0.5)) for c in coverage[:width]])
+
+    # Trim to the ink.
+    columns = [x for x in range(width) if any(r[x] for r in rows)]
+    lines = [y for y in range(len(rows)) if any(rows[y])]
+    if not columns:
+        return 0, 0, []
+    x0, x1 = columns[0], columns[-1]
+    y0, y1 = lines[0], lines[-1]
+    return left + x0, top + y0, [r[x0:x1 + 1] for r in rows[y0:y1 + 1]]
+
+
+def add_span(coverage, a, b):
+    """Adds the covered fraction of each pixel between a and b."""
+    if b <= a:
+        return
+    first = int(math.floor(a))
+    last = int(math.floor(b))
+    if first == last:
+        coverage[first] += b - a
+        return
+    coverage[first] += first + 1 - a
+    for x in range(first + 1, last):
+        coverage[x] += 1.0
+    if last < len(coverage):
+        coverage[last] += b - last
+
+
+def pack_rows(rows):
+    out = bytearray()
+    for row in rows:
+        for i in range(0, len(row), 2):
+            low = row[i]
+            high = row[i + 1] if i + 1 < len(row) else 0
+            out.append(low | (high << 4))
+    return out
+
+
+def ident(name):
+    return "".join(part.capitalize() for part in name.replace("-", "_").split("_"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("font", help="TrueType font file")
+    parser.add_argument("--height", type=int, required=True, help="ink height of --chars in pixels")
+    parser.add_argument("--chars", default="".join(chr(c) for c in range(FIRST_CODE, LAST_CODE + 1)),
+                        help="characters to include (default printable ASCII)")
+    parser.add_argument("--name", required=True, help="font name, e.g. lato14")
+    parser.add_argument("-o", "--output", required=True, help="header to write")
+    args = parser.parse_args()
+
+    font = TrueType(args.font)
+    chars = sorted(set(args.chars))
+    for c in chars:
+        if not FIRST_CODE <= ord(c) <= LAST_CODE:
+            sys.exit(f"{c!r}: only printable ASCII is supported")
+
+    # Ink extent of the chosen characters sets the scale.
+    outlines = {c: font.contours(font.cmap.get(ord(c), 0)) for c in chars}
+    ys = [y for contours in outlines.values() for contour in contours for _, y, _ in contour]
+    if not ys:
+        sys.exit("no outlines for --chars")
+    scale = args.height / (max(ys) - min(ys))
+
+    glyphs = []
+    for c in chars:
+        left, top, rows = rasterize([flatten(contour, scale) for contour in outlines[c]])
+        advance = int(round(font.advance(font.cmap.get(ord(c), 0)) * scale))
+        glyphs.append((c, left, top, rows, advance))
+
+    ascent = max([-top for _, _, top, rows, _ in glyphs if rows] + [0])
+    descent = max([top + len(rows) for _, _, top, rows, _ in glyphs if rows] + [0])
+    height = ascent + descent
+
+    symbol = ident(args.name)
+    bitmaps = bytearray()
+    entries = []
+    for c, left, top, rows, advance in glyphs:
+        width = len(rows[0]) if rows else 0
+        entries.append((c, len(bitmaps), width, len(rows), left, top + ascent if rows else 0, advance))
+        bitmaps += pack_rows(rows)
+    if len(bitmaps) > 0xFFFF:
+        sys.exit("glyph bitmaps exceed 64 KB; use fewer characters or a smaller height")
+
+    index = [NO_GLYPH] * (LAST_CODE - FIRST_CODE + 1)
+    for i, (c, *_rest) in enumerate(entries):
+        index[ord(c) - FIRST_CODE] = i
+
+    source = os.path.basename(args.font)
+    lines = [
+        "#pragma once",
+        "",
+        f"// Generated by tools/font_convert.py from {source} at --height {args.height}; do not edit.",
+        "",
+        '#include "aa_text.h"',
+        "",
+        "namespace graphics {",
+        "namespace fonts {",
+        "",
+        f"inline constexpr uint8_t k{symbol}Index[{len(index)}] = {{",
+    ]
+    for i in range(0, len(index), 16):
+        lines.append("  " + ",".join(f"0x{v:02x}" for v in index[i:i + 16]) + ",")
+    lines += ["};", "", f"inline constexpr AaGlyph k{symbol}Glyphs[{len(entries)}] = {{"]
+    for c, offset, width, rows, left, top, advance in entries:
+        lines.append(f"  {{{offset}, {width}, {rows}, {left}, {top}, {advance}}},  // {c!r}")
+    lines += ["};", "", f"inline constexpr uint8_t k{symbol}Bitmaps[{max(1, len(bitmaps))}] = {{"]
+    for i in range(0, max(1, len(bitmaps)), 16):
+        lines.append("  " + ",".join(f"0x{v:02x}" for v in (bitmaps or b"\0")[i:i + 16]) + ",")
+    lines += [
+        "};",
+        "",
+        f"inline constexpr AaFont k{symbol} = {{k{symbol}Index, k{symbol}Glyphs, k{symbol}Bitmaps, {height}, {ascent}}};",
+        "",
+        "}  // namespace fonts",
+        "}  // namespace graphics",
+        "",
+    ]
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines))
+    print(f"{args.output}: {len(entries)} glyphs, {height} px line, {len(bitmaps)} B of bitmaps")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""Packs PNG images into the image partition read by src/image_pack.cpp.
+
+    python tools/image_pack.py -o images.bin dial.png icons/bolt.png
+    esptool.py --chip esp32s3 write_flash 0x670000 images.bin
+
+Each image is stored as RGB565 rows, every row run-length encoded on its
+own so the watch can decode any row straight from flash. Transparent
+pixels are blended over --background. The offset is that of the
+`images` partition in partitions.csv. Only the standard library is
+needed: 8-bit, non-interlaced PNGs are decoded here.
+
+Layout, little-endian:
+    header   "HIMG", u16 version, u16 image count, u32 total size
+    entries  per image: name (16 bytes, NUL padded), u16 width,
+             u16 height, u32 offset of its data from the pack start
+    data     per image: u32 offset of each row from the end of this
+             table, then the rows
+    rows     ops until the row is full: a byte n < 0x80 is followed by
+             n + 1 literal pixels, a byte 0x80 | n by one pixel that
+             repeats n + 1 times
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"HIMG"
+VERSION = 1
+NAME_BYTES = 16
+MAX_OP_PIXELS = 128
+# A run shorter than this costs more as a run than inside a literal.
+MIN_RUN = 2
+
+
+def read_png(path):
+    """Returns (width, height, rows of (r, g, b, a) tuples)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError(f"{path}: not a PNG")
+
+    pos = 8
+    idat = b""
+    palette = []
+    alphas = b""
+    header = None
+    while pos < len(data):
+        (length,) = struct.unpack(">I", data[pos:pos + 4])
+        kind = data[pos + 4:pos + 8]
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            alphas = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    width, height, depth, color_type, _, _, interlace = header
+    if depth != 8 or interlace:
+        raise ValueError(f"{path}: only 8-bit, non-interlaced PNGs are supported")
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        kind = raw[start]
+        line = bytearray(raw[start + 1:start + 1 + stride])
+        for i in range(stride):
+            left = line[i - channels] if i >= channels else 0
+            up = previous[i]
+            corner = previous[i - channels] if i >= channels else 0
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (left + up) // 2) & 0xFF
+            elif kind == 4:
+                p = left + up - corner
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - corner)
+                predictor = left if pa <= pb and pa <= pc else (up if pb <= pc else corner)
+                line[i] = (line[i] + predictor) & 0xFF
+        previous = line
+
+        pixels = []
+        for x in range(width):
+            px = line[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                pixels.append((px[0], px[0], px[0], 255))
+            elif color_type == 2:
+                pixels.append((px[0], px[1], px[2], 255))
+            elif color_type == 3:
+                alpha = alphas[px[0]] if px[0] < len(alphas) else 255
+                pixels.append(palette[px[0]] + (alpha,))
+            elif color_type == 4:
+                pixels.append((px[0], px[0], px[0], px[1]))
+            else:
+                pixels.append(tuple(px))
+        rows.append(pixels)
+    return width, height, rows
+
+
+def to_rgb565(pixel, background):
+    r, g, b, a = pixel
+    r = (r * a + background[0] * (255 - a)) // 255
+    g = (g * a + background[1] * (255 - a)) // 255
+    b = (b * a + background[2] * (255 - a)) // 255
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def encode_row(colors):
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_OP_PIXELS]
+            del literal[:MAX_OP_PIXELS]
+            out.append(len(chunk) - 1)
+            for color in chunk:
+                out.extend(struct.pack("<H", color))
+
+    i = 0
+    while i < len(colors):
+        run = 1
+        while i + run < len(colors) and colors[i + run] == colors[i] and run < MAX_OP_PIXELS:
+            run += 1
+        if run >= MIN_RUN:
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.extend(struct.pack("<H", colors[i]))
+        else:
+            literal.extend(colors[i:i + run])
+        i += run
+    flush_literal()
+    return bytes(out)
+
+
+def encode_image(width, height, rows, background):
+    encoded = [encode_row([to_rgb565(p, background) for p in row]) for row in rows]
+    table = bytearray()
+    offset = 0
+    for row in encoded:
+        table += struct.pack("<I", offset)
+        offset += len(row)
+    return bytes(table) + b"".join(encoded)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("images", nargs="+", help="PNG files; each is named after its file name")
+    parser.add_argument("-o", "--output", required=True, help="pack to write")
+    parser.add_argument("--background", default="000000",
+                        help="RRGGBB that transparent pixels are blended over (default black)")
+    args = parser.parse_args()
+
+    background = tuple(int(args.background[i:i + 2], 16) for i in (0, 2, 4))
+    entries = []
+    for path in args.images:
+        name = os.path.splitext(os.path.basename(path))[0]
+        if len(name.encode()) >= NAME_BYTES:
+            sys.exit(f"{path}: name longer than {NAME_BYTES - 1} bytes")
+        width, height, rows = read_png(path)
+        if width > 240 or height > 240:
+            sys.exit(f"{path}: larger than the 240x240 screen")
+        data = encode_image(width, height, rows, background)
+        entries.append((name, width, height, data))
+        print(f"{name}: {width}x{height}, {len(data)} B ({100 * len(data) // (2 * width * height)}% of RGB565)")
+
+    header_size = 12 + len(entries) * (NAME_BYTES + 8)
+    directory = bytearray()
+    blobs = bytearray()
+    for name, width, height, data in entries:
+        # Row tables start on a 4-byte boundary.
+        while (header_size + len(blobs)) % 4:
+            blobs.append(0)
+        directory += name.encode().ljust(NAME_BYTES, b"\0")
+        directory += struct.pack("<HHI", width, height, header_size + len(blobs))
+        blobs += data
+    total = header_size + len(blobs)
+    pack = MAGIC + struct.pack("<HHI", VERSION, len(entries), total) + directory + blobs
+    with open(args.output, "wb") as f:
+        f.write(pack)
+    print(f"{args.output}: {len(entries)} image(s), {total} B")
+
+
+if __name__ == "__main__":
+    main()